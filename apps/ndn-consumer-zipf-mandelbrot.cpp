@@ -21,7 +21,8 @@
 
 #include "ndn-consumer-zipf-mandelbrot.hpp"
 
-#include <math.h>
+#include <map>
+#include <tuple>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
@@ -74,20 +75,40 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 {
   m_N = numOfContents;
+  m_table = nullptr; // rebuilt on next use, after all attributes are set
 
   NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
+}
 
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
+shared_ptr<const AliasTable>
+ConsumerZipfMandelbrot::GetTable(uint32_t n, double q, double s)
+{
+  // tables stay alive only while some consumer uses them
+  static std::map<std::tuple<uint32_t, double, double>, std::weak_ptr<const AliasTable>> tables;
+
+  auto key = std::make_tuple(n, q, s);
+  auto entry = tables.find(key);
+  if (entry != tables.end()) {
+    shared_ptr<const AliasTable> table = entry->second.lock();
+    if (table != nullptr) {
+      return table;
+    }
   }
 
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+  // drop tables of consumers that are gone
+  for (auto i = tables.begin(); i != tables.end();) {
+    if (i->second.expired()) {
+      i = tables.erase(i);
+    }
+    else {
+      ++i;
+    }
   }
+
+  NS_LOG_DEBUG("Building alias table for N=" << n << ", q=" << q << ", s=" << s);
+  auto table = make_shared<AliasTable>(AliasTable::makeZipfMandelbrotWeights(n, q, s));
+  tables[key] = table;
+  return table;
 }
 
 uint32_t
@@ -134,21 +155,8 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s max -> " << m_seqMax << "\n";
 
-  while (m_retxSeqs.size()) {
-    seq = *m_retxSeqs.begin();
-    m_retxSeqs.erase(m_retxSeqs.begin());
-
-    // NS_ASSERT (m_seqLifetimes.find (seq) != m_seqLifetimes.end ());
-    // if (m_seqLifetimes.find (seq)->time <= Simulator::Now ())
-    //   {
-
-    //     NS_LOG_DEBUG ("Expire " << seq);
-    //     m_seqLifetimes.erase (seq); // lifetime expired. Trying to find another unexpired
-    //     sequence number
-    //     continue;
-    //   }
-    NS_LOG_DEBUG("=interest seq " << seq << " from m_retxSeqs");
-    break;
+  if (PopRetxSeq(seq)) {
+    NS_LOG_DEBUG("=interest seq " << seq << " from retransmission queue");
   }
 
   if (seq == std::numeric_limits<uint32_t>::max()) // no retransmission
@@ -176,18 +184,7 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-  NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
-
-  m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -198,24 +195,15 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (m_N == 0) {
+    return 1; // no distribution to sample from
+  }
 
-  double p_random = m_seqRng->GetValue();
-  while (p_random == 0) {
-    p_random = m_seqRng->GetValue();
+  if (m_table == nullptr) {
+    m_table = GetTable(m_N, m_q, m_s);
   }
-  // if (p_random == 0)
-  NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  uint32_t content_index = m_table->sample(m_seqRng->GetValue()) + 1; //[1, m_N]
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
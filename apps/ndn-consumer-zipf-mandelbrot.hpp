@@ -37,6 +37,8 @@
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
 
+#include "ns3/ndnSIM/utils/ndn-alias-table.hpp"
+
 namespace ns3 {
 namespace ndn {
 
@@ -47,6 +49,9 @@ namespace ndn {
  * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
  * Here is the explaination of Zipf-Mandelbrot Distribution:
  *http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * Content ranks are drawn in O(1) from an alias table, which is built when the first Interest
+ * is sent and shared by all consumers with the same NumberOfContents, q, and s.
  */
 class ConsumerZipfMandelbrot : public ConsumerCbr {
 public:
@@ -90,11 +95,14 @@ private:
   double
   GetS() const;
 
+  static shared_ptr<const AliasTable>
+  GetTable(uint32_t n, double q, double s);
+
 private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  shared_ptr<const AliasTable> m_table; // built on demand, shared with other consumers
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
@@ -31,6 +31,8 @@
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
+#include "utils/ndn-event-trace.hpp"
+#include "model/ndn-geocast-region.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
 
@@ -39,8 +41,6 @@
 
 #include "ns3/ndnSIM-module.h"
 
-#include <iomanip>
-
 NS_LOG_COMPONENT_DEFINE("ndn.Consumer");
 
 namespace ns3 {
@@ -64,9 +64,14 @@ Consumer::GetTypeId(void)
                     MakeNameAccessor(&Consumer::m_interestName), MakeNameChecker())
       .AddAttribute("LifeTime", "LifeTime for interest packet", StringValue("2s"),
                     MakeTimeAccessor(&Consumer::m_interestLifeTime), MakeTimeChecker())
+      .AddAttribute("TypedGeocastRegion",
+                    "Replace geocast region at the end of Prefix (/x,y,z/x,y,z/limit) with "
+                    "the binary GeocastRegion name component",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&Consumer::m_typedGeocastRegion), MakeBooleanChecker())
 
       .AddAttribute("RetxTimer",
-                    "Timeout defining how frequent retransmission timeouts should be checked",
+                    "Minimum interval between checks of retransmission timeouts",
                     StringValue("50ms"),
                     MakeTimeAccessor(&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                     MakeTimeChecker())
@@ -99,12 +104,9 @@ Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
   if (m_retxEvent.IsRunning()) {
-    // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-    Simulator::Remove(m_retxEvent); // slower, but better for memory
+    Simulator::Remove(m_retxEvent);
+    ScheduleRetxCheck();
   }
-
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
 }
 
 Time
@@ -117,24 +119,68 @@ void
 Consumer::CheckRetxTimeout()
 {
   Time now = Simulator::Now();
+  m_lastRetxCheck = now;
 
   Time rto = m_rtt->RetransmitTimeout();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
+  while (!m_timeoutQueue.empty()) {
+    uint32_t seqNo = m_timeoutQueue.front().first;
+    Time sent = m_timeoutQueue.front().second;
+
+    SeqState* state = m_seqStates.find(seqNo);
+    if (state == nullptr || !state->isPending || state->lastSent != sent) {
+      m_timeoutQueue.pop_front(); // satisfied or sent again later
+      continue;
     }
-    else
+
+    if (sent + rto > now)
       break; // nothing else to do. All later packets need not be retransmitted
+
+    m_timeoutQueue.pop_front();
+    state->isPending = false;
+    OnTimeout(seqNo);
+  }
+
+  ScheduleRetxCheck();
+}
+
+void
+Consumer::ScheduleRetxCheck()
+{
+  if (m_timeoutQueue.empty()) {
+    return;
   }
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  Time deadline = m_timeoutQueue.front().second + m_rtt->RetransmitTimeout();
+  deadline = std::max(deadline, m_lastRetxCheck + m_retxTimer);
+
+  if (m_retxEvent.IsRunning()) {
+    if (TimeStep(m_retxEvent.GetTs()) <= deadline) {
+      return; // the scheduled check will reschedule itself if needed
+    }
+    Simulator::Remove(m_retxEvent);
+  }
+
+  Time delay = std::max(deadline - Simulator::Now(), Time(0));
+  m_retxEvent = Simulator::Schedule(delay, &Consumer::CheckRetxTimeout, this);
+}
+
+bool
+Consumer::PopRetxSeq(uint32_t& sequenceNumber)
+{
+  while (!m_retxQueue.empty()) {
+    uint32_t seq = m_retxQueue.front();
+    m_retxQueue.pop_front();
+
+    SeqState* state = m_seqStates.find(seq);
+    if (state != nullptr && state->isRetxQueued) {
+      state->isRetxQueued = false;
+      sequenceNumber = seq;
+      return true;
+    }
+  }
+  return false;
 }
 
 // Application Methods
@@ -146,6 +192,10 @@ Consumer::StartApplication() // Called at time specified by Start
   // do base stuff
   App::StartApplication();
 
+  if (m_typedGeocastRegion) {
+    m_interestName = GeocastRegion::toTypedPrefix(m_interestName);
+  }
+
   ScheduleNextPacket();
 }
 
@@ -156,6 +206,7 @@ Consumer::StopApplication() // Called at time specified by Stop
 
   // cancel periodic packet generation
   Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_retxEvent);
 
   // cleanup base stuff
   App::StopApplication();
@@ -166,18 +217,12 @@ Consumer::SendPacket()
 {
   if (!m_active)
     return;
-  std::cout << std::setprecision(5) << std::fixed;
+
   NS_LOG_FUNCTION_NOARGS();
 
   uint32_t seq = std::numeric_limits<uint32_t>::max(); // invalid
 
-  while (m_retxSeqs.size()) {
-    seq = *m_retxSeqs.begin();
-    m_retxSeqs.erase(m_retxSeqs.begin());
-    break;
-  }
-
-  if (seq == std::numeric_limits<uint32_t>::max()) {
+  if (!PopRetxSeq(seq)) {
     if (m_seqMax != std::numeric_limits<uint32_t>::max()) {
       if (m_seq >= m_seqMax) {
         return; // we are totally done
@@ -202,8 +247,7 @@ Consumer::SendPacket()
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq);
-  double time = Simulator::Now().ToDouble(Time::S);
-  std::cout<< time << " Interest for " << seq << std::endl;
+  NDNSIM_TRACE_EVENT("Consumer", "Interest", seq, 0);
   WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
@@ -225,40 +269,37 @@ Consumer::OnData(shared_ptr<const Data> data)
   App::OnData(data); // tracing inside
   //this->dataR();
   NS_LOG_FUNCTION(this << data);
-  
-  double time = Simulator::Now().ToDouble(Time::S);
 
   // NS_LOG_INFO ("Received content object: " << boost::cref(*data));
 
   // This could be a problem......
   uint32_t seq = data->getName().at(-1).toSequenceNumber();
   NS_LOG_INFO("< DATA for " << seq);
-  std::cout<< time << " Data for " << seq << std::endl;
   int hopCount = 0;
   auto hopCountTag = data->getTag<lp::HopCountTag>();
   if (hopCountTag != nullptr) { // e.g., packet came from local node's cache
     hopCount = *hopCountTag;
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
-  std::cout<< hopCount<< " Hop Count for " << seq << std::endl;
-
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
+  NDNSIM_TRACE_EVENT("Consumer", "Data", seq, hopCount);
+
+  SeqState* state = m_seqStates.find(seq);
+  if (state != nullptr) {
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - state->lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - state->firstSent, state->retxCount,
+                             hopCount);
+    m_seqStates.erase(seq);
   }
 
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+  // drop satisfied entries, so that the next timeout check is not scheduled for them
+  while (!m_timeoutQueue.empty()) {
+    SeqState* front = m_seqStates.find(m_timeoutQueue.front().first);
+    if (front != nullptr && front->isPending && front->lastSent == m_timeoutQueue.front().second) {
+      break;
+    }
+    m_timeoutQueue.pop_front();
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
-  m_retxSeqs.erase(seq);
-
   m_rtt->AckSeq(SequenceNumber32(seq));
 }
 
@@ -282,7 +323,11 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
   m_rtt->IncreaseMultiplier(); // Double the next RTO
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber),
                  1); // make sure to disable RTT calculation for this sample
-  m_retxSeqs.insert(sequenceNumber);
+  SeqState* state = m_seqStates.find(sequenceNumber);
+  if (state != nullptr && !state->isRetxQueued) {
+    state->isRetxQueued = true;
+    m_retxQueue.push_back(sequenceNumber);
+  }
   ScheduleNextPacket();
 }
 
@@ -290,15 +335,19 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+                                << m_seqStates.size() << " items");
 
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  Time now = Simulator::Now();
+  SeqState& state = m_seqStates.insert(sequenceNumber);
+  if (state.retxCount == 0) {
+    state.firstSent = now;
+  }
+  state.lastSent = now;
+  state.retxCount++;
+  state.isPending = true;
 
-  m_seqRetxCounts[sequenceNumber]++;
+  m_timeoutQueue.emplace_back(sequenceNumber, now);
+  ScheduleRetxCheck();
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 }
@@ -31,13 +31,10 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
 
-#include <set>
-#include <map>
+#include "ns3/ndnSIM/utils/ndn-seq-window.hpp"
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <deque>
+#include <utility>
 
 namespace ns3 {
 namespace ndn {
@@ -114,21 +111,35 @@ protected:
   ScheduleNextPacket() = 0;
 
   /**
-   * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
+   * \brief Fires OnTimeout for all Interests whose retransmission timer expired and schedules
+   * the next check
    */
   void
   CheckRetxTimeout();
 
   /**
-   * \brief Modifies the frequency of checking the retransmission timeouts
-   * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Schedules CheckRetxTimeout at the earliest time the oldest pending Interest can
+   * time out, unless a check is already scheduled before that
+   */
+  void
+  ScheduleRetxCheck();
+
+  /**
+   * \brief Takes the next timed out sequence number that still needs to be retransmitted
+   * \return false if there is nothing to retransmit
+   */
+  bool
+  PopRetxSeq(uint32_t& sequenceNumber);
+
+  /**
+   * \brief Sets the minimum interval between retransmission timeout checks
+   * \param retxTimer Minimum interval between checks
    */
   void
   SetRetxTimer(Time retxTimer);
 
   /**
-   * \brief Returns the frequency of checking the retransmission timeouts
-   * \return Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Returns the minimum interval between retransmission timeout checks
    */
   Time
   GetRetxTimer() const;
@@ -139,72 +150,40 @@ protected:
   uint32_t m_seq;      ///< @brief currently requested sequence number
   uint32_t m_seqMax;   ///< @brief maximum number of sequence number
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
-  Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
+  Time m_retxTimer;    ///< @brief Minimum interval between retransmission timeout checks
   EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
+  Time m_lastRetxCheck; ///< @brief Time of the last retransmission timeout check
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
 
   Time m_offTime;          ///< \brief Time interval between packets
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
+  bool m_typedGeocastRegion; ///< \brief Encode geocast region in the prefix as typed component
 
   /// @cond include_hidden
   /**
-   * \struct This struct contains sequence numbers of packets to be retransmitted
+   * \brief Transmission state of a requested sequence number
    */
-  struct RetxSeqsContainer : public std::set<uint32_t> {
+  struct SeqState {
+    Time lastSent;          ///< \brief time of the last (re)transmission
+    Time firstSent;         ///< \brief time of the first transmission
+    uint32_t retxCount = 0; ///< \brief number of transmissions
+    bool isPending = false; ///< \brief waiting for Data or retransmission timeout
+    bool isRetxQueued = false; ///< \brief timed out and waiting to be retransmitted
   };
 
-  RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
+  SeqWindow<SeqState> m_seqStates; ///< \brief state of all unsatisfied sequence numbers
 
   /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
+   * \brief (sequence number, send time) of transmitted Interests in the order of sending
+   *
+   * Entries are not removed when Data arrives, but skipped once they no longer match
+   * the state of the sequence number.
    */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
+  std::deque<std::pair<uint32_t, Time>> m_timeoutQueue;
 
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  std::deque<uint32_t> m_retxQueue; ///< \brief timed out sequence numbers, in order of timeouts
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
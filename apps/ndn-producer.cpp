@@ -21,13 +21,17 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-event-trace.hpp"
 
+#include <map>
 #include <memory>
+#include <tuple>
 
 NS_LOG_COMPONENT_DEFINE("ndn.Producer");
 
@@ -63,11 +67,17 @@ Producer::GetTypeId(void)
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker())
+      .AddAttribute("UseDataTemplate",
+                    "Encode payload, MetaInfo, and signature once and only add the name for "
+                    "each Interest",
+                    BooleanValue(true), MakeBooleanAccessor(&Producer::m_useTemplate),
+                    MakeBooleanChecker());
   return tid;
 }
 
 Producer::Producer()
+  : m_useTemplate(true)
 {
   NS_LOG_FUNCTION_NOARGS();
 }
@@ -79,6 +89,8 @@ Producer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
+  m_template = nullptr; // attributes could have been changed
+
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 }
 
@@ -90,22 +102,10 @@ Producer::StopApplication()
   App::StopApplication();
 }
 
-void
-Producer::OnInterest(shared_ptr<const Interest> interest)
+shared_ptr<Data>
+Producer::CreateData() const
 {
-  App::OnInterest(interest); // tracing inside
-  std::cout  << "Receieved_by_Producer "<< std::endl;
-  NS_LOG_FUNCTION(this << interest);
-
-  if (!m_active)
-    return;
-
-  Name dataName(interest->getName());
-  // dataName.append(m_postfix);
-  // dataName.appendVersion();
-
   auto data = make_shared<Data>();
-  data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
   data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
@@ -121,11 +121,80 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
 
   data->setSignature(signature);
+  return data;
+}
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+shared_ptr<const Data>
+Producer::GetDataTemplate() const
+{
+  typedef std::tuple<uint32_t, int64_t, uint32_t, Name> Key;
+  static std::map<Key, std::weak_ptr<const Data>> templates;
+
+  Key key(m_virtualPayloadSize, m_freshness.GetMilliSeconds(), m_signature, m_keyLocator);
+  auto entry = templates.find(key);
+  if (entry != templates.end()) {
+    shared_ptr<const Data> data = entry->second.lock();
+    if (data != nullptr) {
+      return data;
+    }
+  }
+
+  // drop templates of producers that are gone
+  for (auto i = templates.begin(); i != templates.end();) {
+    if (i->second.expired()) {
+      i = templates.erase(i);
+    }
+    else {
+      ++i;
+    }
+  }
 
-  // to create real wire encoding
+  shared_ptr<Data> data = CreateData();
+  // elements of the decoded Data reference one shared wire buffer
   data->wireEncode();
+  templates[key] = data;
+  return data;
+}
+
+void
+Producer::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+  NS_LOG_FUNCTION(this << interest);
+
+  if (!m_active)
+    return;
+
+  // sequence number appended by Consumer; 0 for Interests from other applications
+  NDNSIM_TRACE_EVENT("Producer", "Interest",
+                     !interest->getName().empty() && interest->getName().get(-1).isSequenceNumber()
+                       ? interest->getName().get(-1).toSequenceNumber() : 0,
+                     0);
+
+  Name dataName(interest->getName());
+  // dataName.append(m_postfix);
+  // dataName.appendVersion();
+
+  shared_ptr<Data> data;
+  if (m_useTemplate) {
+    if (m_template == nullptr) {
+      m_template = GetDataTemplate();
+    }
+
+    // MetaInfo, Content, and signature blocks still reference the template's buffer; the wire
+    // is encoded once, when the Data is sent or inspected
+    data = make_shared<Data>(*m_template);
+    data->setName(dataName);
+  }
+  else {
+    data = CreateData();
+    data->setName(dataName);
+
+    // to create real wire encoding
+    data->wireEncode();
+  }
+
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
   m_transmittedDatas(data, this, m_face);
   m_appLink->onReceiveData(*data);
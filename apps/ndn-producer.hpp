@@ -59,6 +59,22 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Create Data packet without name, according to the attributes
+   */
+  shared_ptr<Data>
+  CreateData() const;
+
+  /**
+   * @brief Get Data packet without name, according to the attributes
+   *
+   * The packet is created and encoded once and shared by all producers with the same
+   * attributes.  Copies of it share MetaInfo, Content, and signature blocks.
+   */
+  shared_ptr<const Data>
+  GetDataTemplate() const;
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -67,6 +83,9 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  bool m_useTemplate;
+  shared_ptr<const Data> m_template; ///< @brief Data packet without name
 };
 
 } // namespace ndn
@@ -34,6 +34,7 @@ def register_types(module):
         module.add_class('StrategyChoiceHelper')
         module.add_class('AppHelper')
         module.add_class('GlobalRoutingHelper')
+        module.add_class('CustomHelper')
 
         module.add_class('L3Protocol', parent=module.get_root()['ns3::Object'])
 
@@ -117,6 +118,11 @@ def register_methods(root_module):
             param('const std::string&', 'otherNodeName'),
             param('int32_t', 'metric'),
             ], is_const=True, is_static=True)
+        cls.add_method('AddRouteDirect', retval('void'), [
+            param('ns3::Ptr<ns3::Node>', 'node'), param('const ns3::ndn::Name&', 'prefix'),
+            param('std::shared_ptr<ns3::ndn::Face>', 'face'),
+            param('int32_t', 'metric'),
+            ], is_const=True, is_static=True)
     reg_fibhelper(root_module['ns3::ndn::FibHelper'])
 
     def reg_strategychoicehelper(cls):
@@ -148,10 +154,15 @@ def register_methods(root_module):
         cls.add_method('AddOrigin', 'void', [param('const std::string&', 'prefix'), param('const std::string&', 'nodeName')])
         cls.add_method('AddOrigins', 'void', [param('const std::string&', 'prefix'), param('const ns3::NodeContainer&', 'nodes')])
         cls.add_method('AddOriginsForAll', 'void', [])
-        cls.add_method('CalculateRoutes', 'void', [])
+        cls.add_method('CalculateRoutes', 'void', [param('size_t', 'nThreads', default_value='0')])
         cls.add_method('CalculateAllPossibleRoutes', 'void', [])
     reg_GlobalRoutingHelper(root_module['ns3::ndn::GlobalRoutingHelper'])
 
+    def reg_CustomHelper(cls):
+        cls.add_constructor([param('std::string', 'filename')])
+        cls.add_method('Install', 'void', [], is_const=True)
+    reg_CustomHelper(root_module['ns3::ndn::CustomHelper'])
+
     def reg_Name(root_module, cls):
         cls.add_output_stream_operator()
         for op in ['==', '!=', '<', '<=', '>', '>=']:
@@ -273,6 +273,8 @@ int main (int argc, char *argv[])
 
   ::ns3::ndn::AppHelper consumerHelper("ns3::ndn::ConsumerBatches");
   consumerHelper.SetPrefix("/v2safety/8thStreet/0,0,0/200,0,0/100");
+  // carry the region as a binary name component instead of "x,y,z/x,y,z/limit" strings
+  consumerHelper.SetAttribute("TypedGeocastRegion", BooleanValue(true));
   consumerHelper.SetAttribute("Batches", StringValue("2s 1 3s 1 4s 1 5s 1 6s 1 7s 1 8s 1 9s 1")); // 10 interests a second
   consumerHelper.SetAttribute("RetxTimer", StringValue("1000s"));
   consumerHelper.Install(ueNodes.Get(0));
@@ -288,28 +290,19 @@ int main (int argc, char *argv[])
   // Simulator::Stop(Seconds(2.9)); // expect 1 distinct request
   Simulator::Stop(Seconds(12.99)); // expect 10 distinct requests
   int no = (int) distance;
-  std::ofstream of("results/" + std::to_string(no) +
-                   "-tmin=" + std::to_string(tMin) +
-                   "-tmax=" + std::to_string(tMax) +
-                   "-1hop.csv");
-  of << "Node,Time,Name,Action,X,Y" << std::endl;
-  nfd::fw::DirectedGeocastStrategy::onAction.connect([&of] (const ::ndn::Name& name, int type, double x, double y) {
-      auto context = Simulator::GetContext();
-      auto time = Simulator::Now().ToDouble(Time::S);
-      std::string action;
-      if (type == 0)
-        action = "Broadcast";
-      else if (type == 1)
-        action = "Received";
-      else if (type == 2)
-        action = "Duplicate";
-      else
-        action = "Suppressed";
-      of << context << "," << time << "," << name.get(-1).toSequenceNumber() << "," << action << ","<< x << "," << y <<std::endl;
-    });
+  std::string results = "results/" + std::to_string(no) +
+                        "-tmin=" + std::to_string(tMin) +
+                        "-tmax=" + std::to_string(tMax) +
+                        "-1hop";
+  // actions are recorded in binary and converted to Node,Time,Name,Action,X,Y CSV after the run
+  ns3::ndn::GeocastActionTracer::InstallAll(results + ".bin");
 
   Simulator::Run ();
   Simulator::Destroy ();
+
+  ns3::ndn::GeocastActionTracer::Destroy(); // flush the trace
+  std::ofstream of(results + ".csv");
+  ns3::ndn::GeocastActionTracer::ConvertToCsv(results + ".bin", of);
   return 0;
 
 }
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// geocast-trace-to-csv.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * Converts binary trace produced by ndn::GeocastActionTracer into CSV:
+ *
+ *     ./waf --run "geocast-trace-to-csv --input=results/geocast-trace.bin --output=results/geocast-trace.csv"
+ *
+ * If output is not specified, CSV is written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace file produced by GeocastActionTracer", input);
+  cmd.AddValue("output", "Output CSV file (standard output if empty)", output);
+  cmd.Parse(argc, argv);
+
+  if (input.empty()) {
+    std::cerr << "ERROR: --input must be specified" << std::endl;
+    return 1;
+  }
+
+  std::ofstream of;
+  if (!output.empty()) {
+    of.open(output.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!of.is_open()) {
+      std::cerr << "ERROR: cannot open " << output << " for writing" << std::endl;
+      return 1;
+    }
+  }
+
+  try {
+    ndn::GeocastActionTracer::ConvertToCsv(input, output.empty() ? std::cout : of);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
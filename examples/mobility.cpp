@@ -3,7 +3,7 @@
 #include <sstream>
 #include "ns3/core-module.h"
 #include "ns3/mobility-module.h"
-#include "ns3/custom-helper.h"
+#include "ns3/ndnSIM/helper/custom-helper.hpp"
 #include "ns3/lte-module.h"
 #include "ns3/network-module.h"
 #include "ns3/internet-module.h"
@@ -129,7 +129,7 @@ int main(int argc, char *argv[])
 
   NS_LOG_INFO ("Deploying UE's...");
 
-  CustomHelper ns2 = CustomHelper (traceFile);
+  ndn::CustomHelper ns2 = ndn::CustomHelper (traceFile);
 
   // open log file for output
   std::ofstream os;
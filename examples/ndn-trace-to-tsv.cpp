@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-to-tsv.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * Converts binary trace produced by ndn::AppDelayTracer, ndn::L3RateTracer, L2RateTracer, or
+ * ndn::CsTracer (trace file name ending with .bin or .bin.gz) into the tab-separated format
+ * that the tracer writes to text files:
+ *
+ *     ./waf --run "ndn-trace-to-tsv --input=results/rate-trace.bin.gz --output=results/rate-trace.txt"
+ *
+ * If output is not specified, the trace is written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace file (.bin or .bin.gz)", input);
+  cmd.AddValue("output", "Output file (standard output if empty)", output);
+  cmd.Parse(argc, argv);
+
+  if (input.empty()) {
+    std::cerr << "ERROR: --input must be specified" << std::endl;
+    return 1;
+  }
+
+  std::ofstream of;
+  if (!output.empty()) {
+    of.open(output.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!of.is_open()) {
+      std::cerr << "ERROR: cannot open " << output << " for writing" << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& os = output.empty() ? std::cout : of;
+
+  try {
+    ndn::TraceReader reader(input);
+    switch (reader.GetFormat()) {
+    case ndn::TraceSink::APP_DELAY:
+      ndn::AppDelayTracer::ConvertToTsv(reader, os);
+      break;
+    case ndn::TraceSink::L3_RATE:
+      ndn::L3RateTracer::ConvertToTsv(reader, os);
+      break;
+    case ndn::TraceSink::L2_RATE:
+      L2RateTracer::ConvertToTsv(reader, os);
+      break;
+    case ndn::TraceSink::CS:
+      ndn::CsTracer::ConvertToTsv(reader, os);
+      break;
+    default:
+      std::cerr << "ERROR: unknown trace format " << reader.GetFormat() << std::endl;
+      return 1;
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,347 @@
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/ndnSIM/utils/ndn-ns2-trace-line.hpp"
+#include "custom-helper.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+NS_LOG_COMPONENT_DEFINE ("ndn.CustomHelper");
+
+/**
+ * Movements are read from the trace up to this many seconds ahead of the
+ * current simulation time.
+ */
+static const double READ_AHEAD = 10.0;
+
+/**
+ * Applied movements are removed from the front of the array of a node once
+ * there are at least this many of them and they make up half of the array.
+ */
+static const size_t MIN_COMPACTION = 64;
+
+namespace {
+
+/**
+ * Movement of a node, as given by a scheduled setdest or set line
+ */
+struct Waypoint
+{
+  double time;
+  int coordinate;  //!< coordinate changed by a set line, or -1 for setdest
+  Vector position; //!< position (setdest), or value in the changed coordinate (set)
+  Vector velocity; //!< velocity (setdest)
+};
+
+/**
+ * Streams the trace file and keeps, for every node, time-ordered movements
+ * that have been read but not yet applied.
+ */
+class TraceLoader : public SimpleRefCount<TraceLoader>
+{
+public:
+  TraceLoader (const std::string &filename, const std::vector<Ptr<Object> > &objects);
+
+  /**
+   * Read the trace up to READ_AHEAD seconds from now, schedule next movement of
+   * nodes which got new ones, and schedule the next read
+   */
+  void ReadAhead ();
+
+private:
+  struct NodeState
+  {
+    Ptr<ConstantVelocityMobilityModel> model;
+    bool isResolved = false;
+    std::vector<Waypoint> waypoints; //!< sorted by time
+    size_t next = 0;                 //!< index of the next waypoint to apply
+    EventId event;
+  };
+
+  void ProcessLine ();
+
+  NodeState* GetNode (uint32_t id);
+
+  void AddWaypoint (uint32_t id, const Waypoint &waypoint);
+
+  void ScheduleNext (uint32_t id);
+
+  void ApplyNext (uint32_t id);
+
+private:
+  std::ifstream m_file;
+  std::string m_line;
+  uint64_t m_lineNo;
+  double m_readTime; //!< latest movement time read so far
+
+  std::vector<Ptr<Object> > m_objects;
+  std::vector<NodeState> m_nodes;
+};
+
+} // namespace
+
+static void
+SetCoordinate (Vector &position, int coordinate, double value)
+{
+  switch (coordinate)
+    {
+    case 0:
+      position.x = value;
+      break;
+    case 1:
+      position.y = value;
+      break;
+    default:
+      position.z = value;
+      break;
+    }
+}
+
+static double
+GetCoordinate (const Vector &position, int coordinate)
+{
+  switch (coordinate)
+    {
+    case 0:
+      return position.x;
+    case 1:
+      return position.y;
+    default:
+      return position.z;
+    }
+}
+
+TraceLoader::TraceLoader (const std::string &filename, const std::vector<Ptr<Object> > &objects)
+  : m_file (filename.c_str (), std::ios::in),
+    m_lineNo (0),
+    m_readTime (0),
+    m_objects (objects),
+    m_nodes (objects.size ())
+{
+  if (!m_file.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open trace file " << filename << " for reading");
+    }
+}
+
+void
+TraceLoader::ReadAhead ()
+{
+  double horizon = Simulator::Now ().GetSeconds () + READ_AHEAD;
+  while (m_readTime <= horizon && std::getline (m_file, m_line))
+    {
+      ++m_lineNo;
+      ProcessLine ();
+    }
+
+  if (m_file)
+    {
+      // read the next portion when half of the read-ahead window is consumed
+      double delay = m_readTime - READ_AHEAD / 2 - Simulator::Now ().GetSeconds ();
+      Simulator::Schedule (Seconds (std::max (delay, 0.0)), &TraceLoader::ReadAhead, Ptr<TraceLoader> (this));
+    }
+  else
+    {
+      NS_LOG_DEBUG ("Trace file is read completely (" << m_lineNo << " lines)");
+      m_file.close ();
+    }
+}
+
+void
+TraceLoader::ProcessLine ()
+{
+  Ns2TraceLine line;
+  try
+    {
+      line = Ns2TraceLine::Parse (m_line.data (), m_line.data () + m_line.size ());
+    }
+  catch (const std::invalid_argument &e)
+    {
+      NS_LOG_ERROR ("Line " << m_lineNo << " is malformed (" << e.what () << "): " << m_line);
+      return;
+    }
+
+  if (line.type == Ns2TraceLine::EMPTY)
+    {
+      return;
+    }
+
+  if (!line.isScheduled)
+    {
+      // $node_(0) set X_ 11
+      NodeState *node = GetNode (line.node);
+      if (node == 0)
+        {
+          return;
+        }
+      Vector position = node->model->GetPosition ();
+      SetCoordinate (position, line.coordinate, line.value);
+      node->model->SetPosition (position);
+      return;
+    }
+
+  Waypoint waypoint;
+  waypoint.time = line.time;
+  if (line.type == Ns2TraceLine::SET)
+    {
+      // $ns_ at 4 "$node_(0) set X_ 28"
+      waypoint.coordinate = line.coordinate;
+      SetCoordinate (waypoint.position, line.coordinate, line.value);
+    }
+  else
+    {
+      // $ns_ at 1 "$node_(0) setdest 2 3 4 90"
+      waypoint.coordinate = -1;
+      waypoint.position = line.position;
+      waypoint.velocity = line.velocity;
+    }
+
+  AddWaypoint (line.node, waypoint);
+  m_readTime = std::max (m_readTime, waypoint.time);
+}
+
+TraceLoader::NodeState*
+TraceLoader::GetNode (uint32_t id)
+{
+  if (id >= m_nodes.size ())
+    {
+      NS_LOG_ERROR ("Unknown node ID (corrupted file?): " << id);
+      return 0;
+    }
+
+  NodeState &node = m_nodes[id];
+  if (!node.isResolved)
+    {
+      node.isResolved = true;
+      Ptr<Object> object = m_objects[id];
+      if (object != 0)
+        {
+          node.model = object->GetObject<ConstantVelocityMobilityModel> ();
+          if (node.model == 0)
+            {
+              node.model = CreateObject<ConstantVelocityMobilityModel> ();
+              object->AggregateObject (node.model);
+            }
+        }
+    }
+
+  if (node.model == 0)
+    {
+      return 0;
+    }
+  return &node;
+}
+
+void
+TraceLoader::AddWaypoint (uint32_t id, const Waypoint &waypoint)
+{
+  NodeState *node = GetNode (id);
+  if (node == 0)
+    {
+      return;
+    }
+
+  std::vector<Waypoint> &waypoints = node->waypoints;
+  if (waypoints.empty () || waypoints.back ().time <= waypoint.time)
+    {
+      waypoints.push_back (waypoint);
+      if (waypoints.size () - node->next > 1)
+        {
+          return; // next movement is already scheduled
+        }
+    }
+  else
+    {
+      // out-of-order line
+      auto first = waypoints.begin () + node->next;
+      auto i = std::upper_bound (first, waypoints.end (), waypoint.time,
+                                 [] (double time, const Waypoint &w) { return time < w.time; });
+      bool isFirst = i == first;
+      waypoints.insert (i, waypoint);
+      if (!isFirst)
+        {
+          return;
+        }
+      Simulator::Cancel (node->event);
+    }
+  ScheduleNext (id);
+}
+
+void
+TraceLoader::ScheduleNext (uint32_t id)
+{
+  NodeState &node = m_nodes[id];
+  double time = node.waypoints[node.next].time;
+  double delay = time - Simulator::Now ().GetSeconds ();
+  if (delay < 0)
+    {
+      NS_LOG_WARN ("Movement of node " << id << " at " << time << "s is read too late, applying now");
+      delay = 0;
+    }
+  node.event = Simulator::Schedule (Seconds (delay), &TraceLoader::ApplyNext, Ptr<TraceLoader> (this), id);
+}
+
+void
+TraceLoader::ApplyNext (uint32_t id)
+{
+  NodeState &node = m_nodes[id];
+  const Waypoint &waypoint = node.waypoints[node.next++];
+  if (waypoint.coordinate < 0)
+    {
+      node.model->SetPosition (waypoint.position);
+      node.model->SetVelocity (waypoint.velocity);
+    }
+  else
+    {
+      Vector position = node.model->GetPosition ();
+      SetCoordinate (position, waypoint.coordinate,
+                     GetCoordinate (waypoint.position, waypoint.coordinate));
+      node.model->SetPosition (position);
+    }
+
+  if (node.next == node.waypoints.size ())
+    {
+      node.waypoints.clear ();
+      node.next = 0;
+      return;
+    }
+
+  if (node.next >= MIN_COMPACTION && 2 * node.next >= node.waypoints.size ())
+    {
+      node.waypoints.erase (node.waypoints.begin (), node.waypoints.begin () + node.next);
+      node.next = 0;
+    }
+  ScheduleNext (id);
+}
+
+CustomHelper::CustomHelper (std::string filename)
+  : m_filename (filename)
+{
+  std::ifstream file (m_filename.c_str (), std::ios::in);
+  if (!(file.is_open ())) NS_FATAL_ERROR("Could not open trace file " << m_filename.c_str() << " for reading, aborting here \n");
+}
+
+void
+CustomHelper::ConfigNodesMovements (const std::vector<Ptr<Object> > &objects) const
+{
+  Ptr<TraceLoader> loader = Create<TraceLoader> (m_filename, objects);
+  // initial positions and movements read now are scheduled before the simulation starts
+  loader->ReadAhead ();
+}
+
+void
+CustomHelper::Install (void) const
+{
+  Install (NodeList::Begin (), NodeList::End ());
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2007 INRIA
+ *               2009,2010 Contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ * Contributors: Thomas Waldecker <twaldecker@rocketmail.com>
+ *               Martín Giachino <martin.giachino@gmail.com>
+ */
+#ifndef NDNSIM_CUSTOM_HELPER_HPP
+#define NDNSIM_CUSTOM_HELPER_HPP
+
+#include <string>
+#include <stdint.h>
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/object.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * \brief Helper class which can read ns-2 style movement files exported from SUMO
+ *        and configure nodes mobility.
+ *
+ * Each movement line gives position, speed and heading (in degrees) of a node
+ * at the given time:
+ \verbatim
+   $ns_ at $time "$node_(id) setdest x y speed angle"
+ \endverbatim
+ *
+ * Initial positions may also be given with the usual ns-2 statements, which
+ * are applied as soon as they are read, and coordinates may be changed at a
+ * given time:
+ \verbatim
+   $node_(id) set X_ x1
+   $node_(id) set Y_ y1
+   $node_(id) set Z_ z1
+   $ns_ at $time "$node_(id) set X_ x2"
+ \endverbatim
+ *
+ * Lines are parsed with ns3::ndn::Ns2TraceLine, as in WaypointTable::LoadNs2.
+ *
+ * The trace is streamed: only the movements within a few seconds ahead of the
+ * current simulation time are kept in memory (per node, in time order), and
+ * only the next movement of each node is scheduled.  Traces are expected to
+ * be (mostly) sorted by time, as produced by SUMO; a movement that is read
+ * after its time has passed is applied immediately.
+ *
+ * The helper lives in ns3::ndn (log component ndn.CustomHelper), so that it can be linked
+ * together with the ns3::CustomHelper of the patched ns-3 mobility module.
+ */
+class CustomHelper
+{
+public:
+  /**
+   * \param filename filename of file which contains the
+   *        ns2 movement trace.
+   */
+  CustomHelper (std::string filename);
+
+  /**
+   * Read the ns2 trace file and configure the movement
+   * patterns of all nodes contained in the global ns3::NodeList
+   * whose nodeId is matches the nodeId of the nodes in the trace
+   * file.
+   */
+  void Install (void) const;
+
+  /**
+   * \param begin an iterator which points to the start of the input
+   *        object array.
+   * \param end an iterator which points to the end of the input
+   *        object array.
+   *
+   * Read the ns2 trace file and configure the movement
+   * patterns of all input objects. Each input object
+   * is identified by a unique node id which reflects
+   * the index of the object in the input array.
+   */
+  template <typename T>
+  void Install (T begin, T end) const;
+private:
+  /**
+   * Start streaming ns-2 mobility file into ns-3 mobility events
+   * \param objects objects indexed by node id in the trace
+   */
+  void ConfigNodesMovements (const std::vector<Ptr<Object> > &objects) const;
+  std::string m_filename; //!< filename of file containing ns-2 mobility trace 
+};
+
+} // namespace ndn
+} // namespace ns3
+
+namespace ns3 {
+namespace ndn {
+
+template <typename T>
+void 
+CustomHelper::Install (T begin, T end) const
+{
+  std::vector<Ptr<Object> > objects;
+  for (T i = begin; i != end; ++i)
+    {
+      objects.push_back (*i);
+    }
+  ConfigNodesMovements (objects);
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif /* NDNSIM_CUSTOM_HELPER_HPP */
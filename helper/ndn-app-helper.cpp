@@ -86,18 +86,25 @@ Ptr<Application>
 AppHelper::InstallPriv(Ptr<Node> node)
 {
   Ptr<Application> app;
-  Simulator::ScheduleWithContext(node->GetId(), Seconds(0), MakeEvent([=, &app] {
+  auto create = [=, &app] {
 #ifdef NS3_MPI
-        if (MpiInterface::IsEnabled() && node->GetSystemId() != MpiInterface::GetSystemId()) {
-          // don't create an app if MPI is enabled and node is not in the correct partition
-          return 0;
-        }
+    if (MpiInterface::IsEnabled() && node->GetSystemId() != MpiInterface::GetSystemId()) {
+      // don't create an app if MPI is enabled and node is not in the correct partition
+      return;
+    }
 #endif
 
-        app = m_factory.Create<Application>();
-        node->AddApplication(app);
-      }));
-  StackHelper::ProcessWarmupEvents();
+    app = m_factory.Create<Application>();
+    node->AddApplication(app);
+  };
+
+  if (StackHelper::IsInNodeContext(node)) {
+    create();
+  }
+  else {
+    Simulator::ScheduleWithContext(node->GetId(), Seconds(0), MakeEvent(create));
+    StackHelper::ProcessWarmupEvents();
+  }
 
   return app;
 }
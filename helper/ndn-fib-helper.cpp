@@ -39,6 +39,7 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -47,9 +48,31 @@ namespace ndn {
 
 NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 
+void
+FibHelper::AddNextHopToFib(nfd::Forwarder& forwarder, const Name& prefix, nfd::Face& face,
+                           uint64_t cost)
+{
+  // same as what FibManager does for add-nexthop command
+  NS_ASSERT_MSG(forwarder.getFaceTable().get(face.getId()) == &face,
+                "Face " << face.getId() << " does not belong to this node");
+
+  forwarder.getFib().insert(prefix).first->addOrUpdateNextHop(face, 0, cost);
+}
+
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (!l3protocol->isManagementEnabled()) {
+    // no FibManager on the node, update FIB directly
+    shared_ptr<nfd::Forwarder> forwarder = l3protocol->getForwarder();
+    nfd::Face* face = forwarder->getFaceTable().get(parameters.getFaceId());
+    NS_ASSERT_MSG(face != nullptr, "Face " << parameters.getFaceId() << " does not exist");
+
+    AddNextHopToFib(*forwarder, parameters.getName(), *face, parameters.getCost());
+    return;
+  }
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/fib");
@@ -60,13 +83,27 @@ FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
   command->setCanBePrefix(false);
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
 void
 FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (!l3protocol->isManagementEnabled()) {
+    // no FibManager on the node, update FIB directly
+    shared_ptr<nfd::Forwarder> forwarder = l3protocol->getForwarder();
+    nfd::Face* face = forwarder->getFaceTable().get(parameters.getFaceId());
+    nfd::fib::Entry* entry = forwarder->getFib().findExactMatch(parameters.getName());
+    if (face != nullptr && entry != nullptr) {
+      entry->removeNextHop(*face, 0);
+      if (!entry->hasNextHops()) {
+        forwarder->getFib().erase(*entry);
+      }
+    }
+    return;
+  }
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/fib");
@@ -77,7 +114,6 @@ FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
   command->setCanBePrefix(false);
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
@@ -95,6 +131,33 @@ FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, i
   AddNextHop(parameters, node);
 }
 
+void
+FibHelper::AddRouteDirect(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face,
+                          int32_t metric)
+{
+  NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << prefix << " via " << face->getLocalUri()
+                   << " metric " << metric << " (direct)");
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  AddNextHopToFib(*ndn->getForwarder(), prefix, *face, metric);
+}
+
+void
+FibHelper::AddRoutesDirect(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << routes.size() << " routes (direct)");
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  nfd::Forwarder& forwarder = *ndn->getForwarder();
+  for (const auto& route : routes) {
+    AddNextHopToFib(forwarder, route.prefix, *route.face, route.metric);
+  }
+}
+
 void
 FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, uint32_t faceId, int32_t metric)
 {
@@ -128,32 +191,17 @@ FibHelper::AddRoute(const std::string& nodeName, const Name& prefix, uint32_t fa
 void
 FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, Ptr<Node> otherNode, int32_t metric)
 {
-  for (uint32_t deviceId = 0; deviceId < node->GetNDevices(); deviceId++) {
-    Ptr<PointToPointNetDevice> netDevice =
-      DynamicCast<PointToPointNetDevice>(node->GetDevice(deviceId));
-    if (netDevice == 0)
-      continue;
-
-    Ptr<Channel> channel = netDevice->GetChannel();
-    if (channel == 0)
-      continue;
-
-    if (channel->GetDevice(0)->GetNode() == otherNode
-        || channel->GetDevice(1)->GetNode() == otherNode) {
-      Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
-      NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
-
-      shared_ptr<Face> face = ndn->getFaceByNetDevice(netDevice);
-      NS_ASSERT_MSG(face != 0, "There is no face associated with the p2p link");
-
-      AddRoute(node, prefix, face, metric);
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
 
-      return;
-    }
+  auto faces = ndn->getFacesByNeighbor(otherNode);
+  if (faces.empty()) {
+    NS_FATAL_ERROR("Cannot add route: Node# " << node->GetId() << " and Node# "
+                   << otherNode->GetId() << " are not connected");
   }
 
-  NS_FATAL_ERROR("Cannot add route: Node# " << node->GetId() << " and Node# " << otherNode->GetId()
-                                            << " are not connected");
+  // parallel links: use the first one, as in the order of NetDevices on the node
+  AddRoute(node, prefix, faces.front(), metric);
 }
 
 void
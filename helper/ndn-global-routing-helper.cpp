@@ -51,7 +51,13 @@
 #include <boost/foreach.hpp>
 #include <boost/concept/assert.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/graph/detail/d_ary_heap.hpp>
+#include <boost/property_map/property_map.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
 #include <unordered_map>
 
 #include "boost-graph-ndn-global-routing-helper.hpp"
@@ -80,16 +86,11 @@ GlobalRoutingHelper::Install(Ptr<Node> node)
   gr = CreateObject<GlobalRouter>();
   node->AggregateObject(gr);
 
-  for (auto& face : ndn->getForwarder()->getFaceTable()) {
-    auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
-    if (transport == nullptr) {
-      NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
-      continue;
-    }
-
-    Ptr<NetDevice> nd = transport->GetNetDevice();
-    if (nd == 0) {
-      NS_LOG_DEBUG("Not a NetDevice associated with an ndnSIM-specific transport instance");
+  for (uint32_t deviceId = 0; deviceId < node->GetNDevices(); deviceId++) {
+    Ptr<NetDevice> nd = node->GetDevice(deviceId);
+    shared_ptr<Face> face = ndn->getFaceByNetDevice(nd);
+    if (face == nullptr) {
+      NS_LOG_DEBUG("Skipping NetDevice without NDN face");
       continue;
     }
 
@@ -116,7 +117,7 @@ GlobalRoutingHelper::Install(Ptr<Node> node)
         }
         otherGr = otherNode->GetObject<GlobalRouter>();
         NS_ASSERT(otherGr != 0);
-        gr->AddIncidency(face.shared_from_this(), otherGr);
+        gr->AddIncidency(face, otherGr);
       }
     }
     else {
@@ -126,7 +127,7 @@ GlobalRoutingHelper::Install(Ptr<Node> node)
       }
       grChannel = ch->GetObject<GlobalRouter>();
 
-      gr->AddIncidency(face.shared_from_this(), grChannel);
+      gr->AddIncidency(face, grChannel);
     }
   }
 }
@@ -214,67 +215,231 @@ GlobalRoutingHelper::AddOriginsForAll()
   }
 }
 
-void
-GlobalRoutingHelper::CalculateRoutes()
-{
+/// @cond include_hidden
+namespace {
+
+const uint32_t NONE = std::numeric_limits<uint32_t>::max();
+// paths with this or larger cost are considered unreachable (same as boost::WeightInf)
+const uint32_t INF = std::numeric_limits<uint16_t>::max();
+
+/**
+ * @brief Snapshot of NdnGlobalRouterGraph in compressed sparse row form
+ *
+ * Edges of vertex i are [offsets[i], offsets[i + 1]).  Edge weight is the face metric (0 for
+ * edges from a channel to its nodes, which have no face).
+ */
+class CompactRouterGraph {
+public:
+  struct Route
+  {
+    uint32_t destination;
+    uint32_t firstEdge;
+    uint32_t cost;
+  };
+
+  explicit
+  CompactRouterGraph(const boost::NdnGlobalRouterGraph& graph)
+  {
+    std::unordered_map<const GlobalRouter*, uint32_t> indexes;
+    for (const auto& vertex : graph.GetVertices()) {
+      indexes.emplace(PeekPointer(vertex), vertices.size());
+      vertices.push_back(vertex);
+    }
+
+    offsets.reserve(vertices.size() + 1);
+    offsets.push_back(0);
+    for (const auto& vertex : vertices) {
+      for (const auto& incidency : vertex->GetIncidencies()) {
+        const shared_ptr<Face>& face = std::get<1>(incidency);
+        targets.push_back(indexes.at(PeekPointer(std::get<2>(incidency))));
+        weights.push_back(face == nullptr ? 0 : static_cast<uint16_t>(face->getMetric()));
+        faces.push_back(face);
+      }
+      offsets.push_back(targets.size());
+
+      hasPrefixes.push_back(!vertex->GetLocalPrefixes().empty());
+    }
+  }
+
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   * @brief Per-thread buffers of findRoutes
+   */
+  struct Scratch
+  {
+    std::vector<uint32_t> dist;
+    std::vector<uint32_t> firstEdge;
+    std::vector<uint8_t> color;
+    std::vector<size_t> indexInHeap;
+  };
+
+  /**
+   * @brief Dijkstra from @p source, only routes to vertices with local prefixes are returned
+   *
+   * The search visits vertices and edges in the same order as boost::dijkstra_shortest_paths
+   * on NdnGlobalRouterGraph did (same 4-ary heap, same relaxation rule), so that among
+   * equal-cost paths the same first face is chosen.
+   *
+   * Safe to call concurrently with different @p scratch buffers.
    */
+  std::vector<Route>
+  findRoutes(uint32_t source, Scratch& scratch) const
+  {
+    enum : uint8_t {
+      WHITE,
+      GRAY,
+      BLACK
+    };
+
+    std::vector<uint32_t>& dist = scratch.dist;
+    std::vector<uint32_t>& firstEdge = scratch.firstEdge;
+    std::vector<uint8_t>& color = scratch.color;
+    dist.assign(vertices.size(), INF);
+    firstEdge.assign(vertices.size(), NONE);
+    color.assign(vertices.size(), WHITE);
+    scratch.indexInHeap.resize(vertices.size());
+
+    typedef boost::iterator_property_map<uint32_t*, boost::identity_property_map> DistanceMap;
+    typedef boost::iterator_property_map<size_t*, boost::identity_property_map> IndexInHeapMap;
+    boost::d_ary_heap_indirect<uint32_t, 4, IndexInHeapMap, DistanceMap> queue(
+      DistanceMap(dist.data()), IndexInHeapMap(scratch.indexInHeap.data()));
+
+    // breadth_first_visit with dijkstra_bfs_visitor
+    dist[source] = 0;
+    color[source] = GRAY;
+    queue.push(source);
+    while (!queue.empty()) {
+      uint32_t u = queue.top();
+      queue.pop();
+
+      for (uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+        uint32_t v = targets[e];
+        if (color[v] == BLACK) {
+          continue;
+        }
+
+        // relax: keep the first path found with the smallest cost
+        uint32_t newDist = dist[u] + weights[e];
+        bool isDecreased = newDist < dist[v];
+        if (isDecreased) {
+          dist[v] = newDist;
+          // path is attributed to the first face on the way from the source
+          firstEdge[v] = firstEdge[u] != NONE ? firstEdge[u] : (faces[e] != nullptr ? e : NONE);
+        }
 
+        if (color[v] == WHITE) {
+          color[v] = GRAY;
+          queue.push(v);
+        }
+        else if (isDecreased) {
+          queue.update(v);
+        }
+      }
+      color[u] = BLACK;
+    }
+
+    std::vector<Route> routes;
+    for (uint32_t v = 0; v < vertices.size(); ++v) {
+      if (v != source && hasPrefixes[v] && firstEdge[v] != NONE) {
+        routes.push_back({v, firstEdge[v], dist[v]});
+      }
+    }
+    return routes;
+  }
+
+public:
+  std::vector<Ptr<GlobalRouter>> vertices;
+  std::vector<bool> hasPrefixes;
+
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> targets;
+  std::vector<uint32_t> weights;
+  std::vector<shared_ptr<Face>> faces;
+};
+
+} // namespace
+/// @endcond
+
+void
+GlobalRoutingHelper::CalculateRoutes(size_t nThreads)
+{
   BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
   BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  // Shortest paths are computed for every node on a compact copy of the graph, so the
+  // computation does not touch ns-3 objects and can run on multiple threads.  All FIB changes
+  // are done afterwards on this thread.
+  CompactRouterGraph graph{boost::NdnGlobalRouterGraph()};
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
+  std::vector<std::pair<Ptr<Node>, uint32_t>> sources;
+  for (uint32_t i = 0; i < graph.vertices.size(); ++i) {
+    Ptr<Node> node = graph.vertices[i]->GetObject<Node>();
+    if (node != nullptr) {
+      sources.emplace_back(node, i);
     }
+  }
+  // install routes in the same order as nodes appear in NodeList
+  std::sort(sources.begin(), sources.end(),
+            [] (const std::pair<Ptr<Node>, uint32_t>& a, const std::pair<Ptr<Node>, uint32_t>& b) {
+              return a.first->GetId() < b.first->GetId();
+            });
+
+  if (nThreads == 0) {
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  nThreads = std::min(nThreads, std::max<size_t>(1, sources.size()));
+  NS_LOG_DEBUG("Calculating routes for " << sources.size() << " nodes using " << nThreads
+               << " threads");
+
+  // process sources in batches to bound memory used by not yet installed routes
+  const size_t batchSize = nThreads * 64;
+  std::vector<std::vector<CompactRouterGraph::Route>> routes;
+
+  for (size_t batchBegin = 0; batchBegin < sources.size(); batchBegin += batchSize) {
+    size_t batchEnd = std::min(sources.size(), batchBegin + batchSize);
+    routes.assign(batchEnd - batchBegin, {});
+
+    std::atomic<size_t> nextSource(batchBegin);
+    auto worker = [&] {
+      CompactRouterGraph::Scratch scratch;
+      for (size_t i = nextSource++; i < batchEnd; i = nextSource++) {
+        routes[i - batchBegin] = graph.findRoutes(sources[i].second, scratch);
+      }
+    };
 
-    boost::DistancesMap distances;
-
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+    std::vector<FibHelper::Route> fibRoutes;
+    for (size_t i = batchBegin; i < batchEnd; ++i) {
+      Ptr<Node> node = sources[i].first;
+      NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+      fibRoutes.clear();
+      for (const auto& route : routes[i - batchBegin]) {
+        const shared_ptr<Face>& face = graph.faces[route.firstEdge];
+        for (const auto& prefix : graph.vertices[route.destination]->GetLocalPrefixes()) {
+          NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *face
+                       << " with distance " << route.cost);
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
+          fibRoutes.push_back({*prefix, face, static_cast<int32_t>(route.cost)});
         }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
+      }
 
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
+      if (node->GetObject<L3Protocol>()->isManagementEnabled()) {
+        // keep routes going through FibManager, as they would with FibHelper::AddRoute
+        for (const auto& route : fibRoutes) {
+          FibHelper::AddRoute(node, route.prefix, route.face, route.metric);
         }
       }
+      else {
+        FibHelper::AddRoutesDirect(node, fibRoutes);
+      }
     }
   }
 }
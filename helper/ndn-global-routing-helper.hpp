@@ -96,9 +96,20 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * The router graph is first copied into a compact adjacency array, then per-node shortest
+   * path computations run in parallel; FIB entries are installed afterwards on the calling thread.
+   * Among equal-cost paths, the same first face is chosen as with boost::dijkstra_shortest_paths,
+   * regardless of the number of threads.
+   *
+   * Routes are added with FibHelper::AddRoute (through FibManager) on nodes with the full NDN
+   * stack, and directly into the FIB on nodes with the minimal stack (see
+   * StackHelper::enableMinimalStack).
+   *
+   * @param nThreads number of worker threads, 0 to use all available hardware threads
    */
   static void
-  CalculateRoutes();
+  CalculateRoutes(size_t nThreads = 0);
 
   /**
    * @brief Calculate all possible next-hop independent alternative routes
@@ -55,40 +55,33 @@ LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRa
 
   NS_ASSERT(ndn1 != nullptr && ndn2 != nullptr);
 
-  // iterate over all faces to find the right one
-  for (const auto& face : ndn1->getForwarder()->getFaceTable()) {
-    auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
-    if (transport == nullptr)
-      continue;
-
-    Ptr<PointToPointNetDevice> nd1 = transport->GetNetDevice()->GetObject<PointToPointNetDevice>();
-    if (nd1 == nullptr)
-      continue;
-
-    Ptr<Channel> channel = nd1->GetChannel();
-    if (channel == nullptr)
-      continue;
-
-    Ptr<PointToPointChannel> ppChannel = DynamicCast<PointToPointChannel>(channel);
-
-    Ptr<NetDevice> nd2 = ppChannel->GetDevice(0);
-    if (nd2->GetNode() == node1)
-      nd2 = ppChannel->GetDevice(1);
-
-    if (nd2->GetNode() == node2) {
-      ObjectFactory errorFactory("ns3::RateErrorModel");
-      errorFactory.Set("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
-      errorFactory.Set("ErrorRate", DoubleValue(errorRate));
-      if (errorRate <= 0) {
-        errorFactory.Set("IsEnabled", BooleanValue(false));
-      }
-
-      nd1->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
-      nd2->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
-      return;
+  Ptr<PointToPointNetDevice> nd1;
+  auto faces = ndn1->getFacesByNeighbor(node2);
+  if (!faces.empty()) {
+    // parallel links: only the first one is affected
+    auto transport = dynamic_cast<NetDeviceTransport*>(faces.front()->getTransport());
+    if (transport != nullptr) {
+      nd1 = DynamicCast<PointToPointNetDevice>(transport->GetNetDevice());
     }
   }
-  NS_FATAL_ERROR("There is no link to fail between the requested nodes");
+  if (nd1 == nullptr) {
+    NS_FATAL_ERROR("There is no link to fail between the requested nodes");
+  }
+
+  Ptr<Channel> channel = nd1->GetChannel();
+  Ptr<NetDevice> nd2 = channel->GetDevice(0);
+  if (nd2 == nd1)
+    nd2 = channel->GetDevice(1);
+
+  ObjectFactory errorFactory("ns3::RateErrorModel");
+  errorFactory.Set("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
+  errorFactory.Set("ErrorRate", DoubleValue(errorRate));
+  if (errorRate <= 0) {
+    errorFactory.Set("IsEnabled", BooleanValue(false));
+  }
+
+  nd1->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
+  nd2->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
 }
 
 void
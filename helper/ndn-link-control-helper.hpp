@@ -41,7 +41,8 @@ public:
    * The helper will attempt to find NDN link between node1 and
    * node2 and set NDN face to DOWN state
    *
-   * Note that only PointToPointChannels are supported by this helper method
+   * Note that only PointToPointChannels are supported by this helper method.  If the nodes
+   * are connected by several links, only the link with the lowest face id on node1 is failed.
    *
    * @param node1 one node
    * @param node2 another node
@@ -71,7 +72,8 @@ public:
    * The helper will attempt to find NDN link between node1 and
    * node2 and set NDN face to UP state
    *
-   * Note that only PointToPointChannels are supported by this helper method
+   * Note that only PointToPointChannels are supported by this helper method.  If the nodes
+   * are connected by several links, only the link with the lowest face id on node1 is enabled.
    *
    * @param node1 one node
    * @param node2 another node
@@ -36,11 +36,13 @@
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "model/ndn-lte-ue-net-device-transport.hpp"
+#include "model/ndn-position-cache.hpp"
 #include "utils/ndn-time.hpp"
 #include "utils/dummy-keychain.hpp"
 
 #include <limits>
 #include <map>
+#include <unordered_set>
 #include <boost/lexical_cast.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
@@ -55,6 +57,8 @@ namespace ndn {
 StackHelper::StackHelper()
   : m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isMinimalStack(false)
+  , m_isPointerPassing(false)
   , m_needSetDefaultRoutes(false)
 {
   setCustomNdnCxxClocks();
@@ -117,6 +121,7 @@ void
 StackHelper::setCsSize(size_t maxSize)
 {
   m_maxCsSize = maxSize;
+  m_config = nullptr;
 }
 
 void
@@ -138,9 +143,15 @@ StackHelper::setPolicy(const std::string& policy)
 void
 StackHelper::Install(const NodeContainer& c) const
 {
+  // schedule installation on every node first and run all of them in one warm-up pass
+  std::unordered_set<uint32_t> scheduled;
   for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
-    Install(*i);
+    if (!scheduled.insert((*i)->GetId()).second) {
+      NS_FATAL_ERROR("Cannot re-install NDN stack on node " << (*i)->GetId());
+    }
+    scheduleInstall(*i);
   }
+  ProcessWarmupEvents();
 }
 
 void
@@ -151,6 +162,22 @@ StackHelper::InstallAll() const
 
 void
 StackHelper::Install(Ptr<Node> node) const
+{
+  if (IsInNodeContext(node)) {
+    if (node->GetObject<L3Protocol>() != 0) {
+      NS_FATAL_ERROR("Cannot re-install NDN stack on node "
+                     << node->GetId());
+    }
+    doInstall(node);
+    return;
+  }
+
+  scheduleInstall(node);
+  ProcessWarmupEvents();
+}
+
+void
+StackHelper::scheduleInstall(Ptr<Node> node) const
 {
   if (node->GetObject<L3Protocol>() != 0) {
     NS_FATAL_ERROR("Cannot re-install NDN stack on node "
@@ -158,24 +185,43 @@ StackHelper::Install(Ptr<Node> node) const
     return;
   }
   Simulator::ScheduleWithContext(node->GetId(), Seconds(0), &StackHelper::doInstall, this, node);
-  ProcessWarmupEvents();
 }
 
-void
-StackHelper::doInstall(Ptr<Node> node) const
+shared_ptr<const nfd::ConfigSection>
+StackHelper::getConfig() const
 {
-  // async install to ensure proper context
-  Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
+  if (m_config != nullptr) {
+    return m_config;
+  }
 
+  auto config = make_shared<nfd::ConfigSection>(*L3Protocol::getDefaultConfig());
   if (m_isForwarderStatusManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
+    config->put("ndnSIM.disable_forwarder_status_manager", true);
   }
 
   if (m_isStrategyChoiceManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
+    config->put("ndnSIM.disable_strategy_choice_manager", true);
+    config->get_child("authorizations.authorize.privileges").erase("strategy-choice");
+  }
+
+  if (m_isMinimalStack) {
+    config->put("ndnSIM.minimal_stack", true);
   }
 
-  ndn->getConfig().put("tables.cs_max_packets", m_maxCsSize);
+  config->put("tables.cs_max_packets", m_maxCsSize);
+
+  // all nodes installed with the same settings share the config
+  m_config = config;
+  return m_config;
+}
+
+void
+StackHelper::doInstall(Ptr<Node> node) const
+{
+  // async install to ensure proper context
+  Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
+
+  ndn->setConfig(getConfig());
 
   ndn->setCsReplacementPolicy(m_csPolicyCreationFunc);
 
@@ -285,11 +331,11 @@ StackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   opts.allowReassembly = true;
   opts.allowCongestionMarking = true;
 
-  auto mobility = node->GetObject<MobilityModel>();
-  if (mobility != nullptr) {
-    opts.enableGeoTags = [mobility] {
-      auto pos = mobility->GetPosition();
-      return std::make_shared<::ndn::lp::GeoTag>(std::make_tuple(pos.x, pos.y, pos.z));
+  if (node->GetObject<MobilityModel>() != nullptr) {
+    Ptr<PositionCache> positionCache = PositionCache::getPositionCache(node);
+    opts.enableGeoTags = [positionCache] {
+      auto pos = positionCache->GetPosition();
+      return std::make_shared<::ndn::lp::GeoTag>(std::make_tuple(pos->x, pos->y, pos->z));
     };
   }
 
@@ -320,11 +366,11 @@ StackHelper::LteUeNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<Net
   opts.allowReassembly = true;
   opts.allowCongestionMarking = true;
 
-  auto mobility = node->GetObject<MobilityModel>();
-  if (mobility != nullptr) {
-    opts.enableGeoTags = [mobility] {
-      auto pos = mobility->GetPosition();
-      return std::make_shared<::ndn::lp::GeoTag>(std::make_tuple(pos.x, pos.y, pos.z));
+  if (node->GetObject<MobilityModel>() != nullptr) {
+    Ptr<PositionCache> positionCache = PositionCache::getPositionCache(node);
+    opts.enableGeoTags = [positionCache] {
+      auto pos = positionCache->GetPosition();
+      return std::make_shared<::ndn::lp::GeoTag>(std::make_tuple(pos->x, pos->y, pos->z));
     };
   }
 
@@ -332,7 +378,8 @@ StackHelper::LteUeNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<Net
 
   auto transport = make_unique<LteUeNetDeviceTransport>(node, netDevice,
                                                         "lte://",
-                                                        "udp://225.63.63.1:6363");
+                                                        std::string("lte://") +
+                                                        LteUeNetDeviceTransport::GROUP_ADDRESS);
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
@@ -420,6 +467,12 @@ StackHelper::createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetD
     face = DefaultNetDeviceCallback(node, ndn, device);
   }
 
+  if (m_isPointerPassing) {
+    if (auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport())) {
+      transport->SetPointerPassing(true);
+    }
+  }
+
   if (m_needSetDefaultRoutes) {
     // default route with lowest priority possible
     FibHelper::AddRoute(node, "/", face, std::numeric_limits<int32_t>::max());
@@ -431,12 +484,27 @@ void
 StackHelper::disableStrategyChoiceManager()
 {
   m_isStrategyChoiceManagerDisabled = true;
+  m_config = nullptr;
 }
 
 void
 StackHelper::disableForwarderStatusManager()
 {
   m_isForwarderStatusManagerDisabled = true;
+  m_config = nullptr;
+}
+
+void
+StackHelper::enableMinimalStack()
+{
+  m_isMinimalStack = true;
+  m_config = nullptr;
+}
+
+void
+StackHelper::enablePointerPassing()
+{
+  m_isPointerPassing = true;
 }
 
 void
@@ -479,6 +547,12 @@ StackHelper::ProcessWarmupEvents()
 #endif // HAVE_NS3_VISUALIZER
 }
 
+bool
+StackHelper::IsInNodeContext(Ptr<Node> node)
+{
+  return Simulator::GetContext() == node->GetId();
+}
+
 
 } // namespace ndn
 } // namespace ns3
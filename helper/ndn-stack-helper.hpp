@@ -30,7 +30,10 @@
 #include "ndn-fib-helper.hpp"
 #include "ndn-strategy-choice-helper.hpp"
 
+#include <boost/property_tree/ptree_fwd.hpp>
+
 namespace nfd {
+typedef boost::property_tree::ptree ConfigSection;
 namespace cs {
 class Policy;
 } // namespace cs
@@ -140,6 +143,9 @@ public:
    *
    * \param node The node on which to install the stack.
    *
+   * Within a simulator event of the node (see IsInNodeContext), the stack is installed
+   * directly, without a warm-up pass.
+   *
    * \returns list of installed faces in the form of a smart pointer
    * to FaceContainer object
    */
@@ -152,6 +158,8 @@ public:
    * The program will assert if this method is called on a container with a node
    * that already has an ndn object aggregated to it.
    *
+   * Stacks on all nodes are created within a single warm-up pass of the simulator.
+   *
    * \param c NodeContainer that holds the set of nodes on which to install the
    * new stacks.
    *
@@ -221,6 +229,30 @@ public:
   void
   disableForwarderStatusManager();
 
+  /**
+   * \brief Install NDN stack without NFD management and RIB service
+   *
+   * In the minimal mode, nodes only get the forwarder with its tables and faces.  Dispatcher,
+   * command authenticator, all managers, internal faces and rib::Service are not created, which
+   * substantially reduces memory footprint and installation time for large topologies.
+   *
+   * FibHelper and StrategyChoiceHelper update forwarder tables directly on such nodes;
+   * applications cannot use /localhost/nfd commands (e.g., prefix registration through
+   * ndn::Face::registerPrefix).
+   */
+  void
+  enableMinimalStack();
+
+  /**
+   * \brief Pass NDN packets between NetDeviceTransports in memory instead of serializing them
+   *
+   * Faces with NetDeviceTransport created by this helper (including those created by custom
+   * face callbacks) are put into pointer-passing mode, see NetDeviceTransport::SetPointerPassing.
+   * Blocks are released once received by all neighbors, see BlockTag.
+   */
+  void
+  enablePointerPassing();
+
   /**
    * @brief Set face metric of all faces connected through PointToPoint channel to channel latency
    */
@@ -230,7 +262,21 @@ public:
   static void
   ProcessWarmupEvents();
 
+  /**
+   * @brief Check whether the current simulator event runs in the context of @p node
+   *
+   * Helpers configure a node in an event scheduled in its context and processed by
+   * ProcessWarmupEvents.  Within an event of the node itself, e.g., in callbacks of
+   * TraceReplayMobilityHelper::InstallOnDemand, they configure it directly instead, because
+   * the nested run of the simulator would stop the running simulation.
+   */
+  static bool
+  IsInNodeContext(Ptr<Node> node);
+
 private:
+  void
+  scheduleInstall(Ptr<Node> node) const;
+
   void
   doInstall(Ptr<Node> node) const;
 
@@ -250,8 +296,16 @@ private:
   shared_ptr<Face>
   createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const;
 
+  /**
+   * \brief Get NFD config for the current settings, shared by all nodes installed with them
+   */
+  shared_ptr<const nfd::ConfigSection>
+  getConfig() const;
+
   bool m_isForwarderStatusManagerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isMinimalStack;
+  bool m_isPointerPassing;
 
 public:
   void
@@ -262,6 +316,7 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize = 100;
+  mutable shared_ptr<const nfd::ConfigSection> m_config; ///< \brief cached result of getConfig
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
   PolicyCreationCallback m_csPolicyCreationFunc;
@@ -23,6 +23,9 @@
 
 #include "ndn-stack-helper.hpp"
 
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/strategy-choice.hpp"
+
 namespace ns3 {
 namespace ndn {
 
@@ -32,6 +35,13 @@ void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
   NS_LOG_DEBUG("Strategy choice command was initialized");
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (!l3protocol->isManagementEnabled()) {
+    // no StrategyChoiceManager on the node, update StrategyChoice table directly
+    insertStrategy(parameters.getName(), parameters.getStrategy(), node);
+    return;
+  }
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/strategy-choice");
@@ -42,16 +52,36 @@ StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node>
   command->setCanBePrefix(false);
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
+void
+StrategyChoiceHelper::insertStrategy(const Name& namePrefix, const Name& strategy, Ptr<Node> node)
+{
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  auto result = l3protocol->getForwarder()->getStrategyChoice().insert(namePrefix, strategy);
+  if (!result) {
+    NS_FATAL_ERROR("Failed to set strategy " << strategy << " for " << namePrefix
+                   << " on node " << node->GetId() << ": " << result);
+  }
+}
+
 void
 StrategyChoiceHelper::Install(const NodeContainer& c, const Name& namePrefix, const Name& strategy)
 {
+  NS_LOG_DEBUG("Setting forwarding strategy " << strategy << " for " << namePrefix
+               << " on " << c.GetN() << " nodes");
+
+  ControlParameters parameters;
+  parameters.setName(namePrefix);
+  parameters.setStrategy(strategy);
+
+  // all nodes are processed within a single warm-up pass
   for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
-    Install(*i, namePrefix, strategy);
+    Simulator::ScheduleWithContext((*i)->GetId(), Seconds(0),
+                                   &StrategyChoiceHelper::sendCommand, parameters, *i);
   }
+  StackHelper::ProcessWarmupEvents();
 }
 
 void
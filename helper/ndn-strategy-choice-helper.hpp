@@ -56,6 +56,10 @@ using ::ndn::nfd::ControlParameters;
  * The Strategy Choice helper interacts with the Strategy Choice manager of NFD by sending
  * special Interest commands to the manager in order to specify the desired per-name
  * prefix forwarding strategy for one, more or all the nodes of a topology.
+ *
+ * On nodes with the minimal stack (see StackHelper::enableMinimalStack), which have no
+ * manager, the StrategyChoice table is updated directly.  Container and InstallAll variants
+ * process all nodes in a single warm-up pass.
  */
 class StrategyChoiceHelper
 {
@@ -106,6 +110,9 @@ public:
 private:
   static void
   sendCommand(const ControlParameters& parameters, Ptr<Node> node);
+
+  static void
+  insertStrategy(const Name& namePrefix, const Name& strategy, Ptr<Node> node);
 };
 
 template<class Strategy>
@@ -127,9 +134,11 @@ template<class Strategy>
 inline void
 StrategyChoiceHelper::Install(const NodeContainer& c, const Name& namePrefix)
 {
-  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
-    Install<Strategy>(*i, namePrefix);
+  if (!Strategy::canCreate(Strategy::getStrategyName())) {
+    Strategy::template registerType<Strategy>();
   }
+
+  Install(c, namePrefix, Strategy::getStrategyName());
 }
 
 template<class Strategy>
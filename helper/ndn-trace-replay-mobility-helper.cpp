@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-replay-mobility-helper.hpp"
+
+#include "ns3/ndnSIM/model/ndn-trace-replay-mobility-model.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceReplayMobilityHelper");
+
+namespace ns3 {
+namespace ndn {
+
+TraceReplayMobilityHelper::TraceReplayMobilityHelper(const std::string& file)
+  : m_table(boost::algorithm::ends_with(file, ".xml") ? WaypointTable::LoadFcd(file)
+                                                      : WaypointTable::LoadNs2(file))
+  , m_parkingPosition(1e6, 1e6, 0)
+{
+}
+
+void
+TraceReplayMobilityHelper::SetParkingPosition(const Vector& position)
+{
+  m_parkingPosition = position;
+}
+
+void
+TraceReplayMobilityHelper::Install(const NodeContainer& nodes) const
+{
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    Install(nodes.Get(i), i);
+  }
+}
+
+void
+TraceReplayMobilityHelper::InstallAll() const
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Install(*node, (*node)->GetId());
+  }
+}
+
+void
+TraceReplayMobilityHelper::Install(Ptr<Node> node, uint32_t track) const
+{
+  if (!m_table->HasTrack(track)) {
+    NS_LOG_DEBUG("Node " << node->GetId() << " has no track in the trace");
+    return;
+  }
+  if (node->GetObject<MobilityModel>() != 0) {
+    NS_LOG_ERROR("Node " << node->GetId() << " already has a MobilityModel, skipping");
+    return;
+  }
+
+  Ptr<TraceReplayMobilityModel> model = CreateObject<TraceReplayMobilityModel>();
+  model->SetTrack(m_table, track);
+  node->AggregateObject(model);
+}
+
+namespace {
+
+/**
+ * @brief Nodes of InstallOnDemand, kept alive by the pending simulator event
+ */
+class VehiclePool : boost::noncopyable, public std::enable_shared_from_this<VehiclePool>
+{
+public:
+  VehiclePool(shared_ptr<WaypointTable> table, const Vector& parkingPosition,
+              TraceReplayMobilityHelper::NodeCallback onCreate,
+              TraceReplayMobilityHelper::VehicleCallback onDepart,
+              TraceReplayMobilityHelper::VehicleCallback onArrive)
+    : m_table(std::move(table))
+    , m_parkingPosition(parkingPosition)
+    , m_onCreate(std::move(onCreate))
+    , m_onDepart(std::move(onDepart))
+    , m_onArrive(std::move(onArrive))
+    , m_next(0)
+  {
+    for (uint32_t track = 0; track < m_table->GetNTracks(); ++track) {
+      double departure = m_table->GetDepartureTime(track);
+      if (std::isinf(departure)) {
+        continue;
+      }
+      m_events.emplace_back(departure, DEPARTURE, track);
+
+      double arrival = m_table->GetArrivalTime(track);
+      if (!std::isinf(arrival)) {
+        m_events.emplace_back(arrival, ARRIVAL, track);
+      }
+    }
+    // at the same time, arrivals go first to free their nodes for departures
+    std::sort(m_events.begin(), m_events.end());
+  }
+
+  void
+  ScheduleNext()
+  {
+    if (m_next == m_events.size()) {
+      return;
+    }
+
+    Time delay = std::max(Seconds(std::get<0>(m_events[m_next])) - Simulator::Now(), Time(0));
+    auto self = shared_from_this();
+    Simulator::Schedule(delay, [self] { self->ProcessDue(); });
+  }
+
+private:
+  void
+  ProcessDue()
+  {
+    Time now = Simulator::Now();
+    while (m_next != m_events.size() && Seconds(std::get<0>(m_events[m_next])) <= now) {
+      uint32_t track = std::get<2>(m_events[m_next]);
+      if (std::get<1>(m_events[m_next]) == DEPARTURE) {
+        Depart(track);
+      }
+      else {
+        Arrive(track);
+      }
+      ++m_next;
+    }
+    ScheduleNext();
+  }
+
+  void
+  Depart(uint32_t track)
+  {
+    Ptr<Node> node;
+    bool isNew = m_parked.empty();
+    if (!isNew) {
+      node = m_parked.back();
+      m_parked.pop_back();
+    }
+    else {
+      node = CreateObject<Node>();
+      node->AggregateObject(CreateObject<TraceReplayMobilityModel>());
+      NS_LOG_DEBUG("Created node " << node->GetId() << " for vehicle "
+                   << m_table->GetTrackName(track));
+    }
+    m_active[track] = node;
+
+    // callbacks run in the context of the node, where helpers install directly instead of
+    // running a warm-up pass that would stop the simulation (see StackHelper::IsInNodeContext)
+    auto self = shared_from_this();
+    Simulator::ScheduleWithContext(node->GetId(), Seconds(0), [self, node, track, isNew] {
+        self->Start(node, track, isNew);
+      });
+  }
+
+  void
+  Start(Ptr<Node> node, uint32_t track, bool isNew)
+  {
+    if (isNew && m_onCreate) {
+      m_onCreate(node);
+    }
+
+    node->GetObject<TraceReplayMobilityModel>()->SetTrack(m_table, track);
+    if (m_onDepart) {
+      m_onDepart(node, m_table->GetTrackName(track));
+    }
+  }
+
+  void
+  Arrive(uint32_t track)
+  {
+    auto i = m_active.find(track);
+    if (i == m_active.end()) {
+      return;
+    }
+    Ptr<Node> node = i->second;
+    m_active.erase(i);
+
+    if (m_onArrive) {
+      m_onArrive(node, m_table->GetTrackName(track));
+    }
+    Ptr<TraceReplayMobilityModel> model = node->GetObject<TraceReplayMobilityModel>();
+    model->ClearTrack();
+    model->SetPosition(m_parkingPosition);
+    m_parked.push_back(node);
+  }
+
+private:
+  enum Kind {
+    ARRIVAL = 0,
+    DEPARTURE = 1
+  };
+
+  shared_ptr<WaypointTable> m_table;
+  Vector m_parkingPosition;
+  TraceReplayMobilityHelper::NodeCallback m_onCreate;
+  TraceReplayMobilityHelper::VehicleCallback m_onDepart;
+  TraceReplayMobilityHelper::VehicleCallback m_onArrive;
+
+  std::vector<std::tuple<double, Kind, uint32_t>> m_events; ///< time, kind, track
+  size_t m_next;
+
+  std::unordered_map<uint32_t, Ptr<Node>> m_active; ///< track => node
+  std::vector<Ptr<Node>> m_parked;
+};
+
+} // namespace
+
+void
+TraceReplayMobilityHelper::InstallOnDemand(const NodeCallback& onCreate,
+                                           const VehicleCallback& onDepart,
+                                           const VehicleCallback& onArrive) const
+{
+  auto pool = make_shared<VehiclePool>(m_table, m_parkingPosition, onCreate, onDepart, onArrive);
+  pool->ScheduleNext();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_HELPER_NDN_TRACE_REPLAY_MOBILITY_HELPER_HPP
+#define NDNSIM_HELPER_NDN_TRACE_REPLAY_MOBILITY_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/vector.h"
+
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+class WaypointTable;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to replay a vehicular mobility trace with TraceReplayMobilityModel
+ *
+ * Unlike CustomHelper, which drives a ConstantVelocityMobilityModel of every node with
+ * scheduled SetVelocity events, the trace is loaded once into a WaypointTable shared by all
+ * nodes, and positions are computed on demand:
+ *
+ *     ndn::TraceReplayMobilityHelper mobility("mobility.tcl");
+ *     mobility.Install(vehicles); // i-th node replays $node_(i) of the trace
+ *
+ * SUMO floating car data (`sumo --fcd-output fcd.xml`) can be used directly, without converting
+ * it to ns-2 format.  Nodes for vehicles can then be created when vehicles depart, and reused
+ * for other vehicles after they arrive, so the number of nodes is the maximum number of
+ * vehicles simultaneously on the road rather than the total number of vehicles:
+ *
+ *     ndn::TraceReplayMobilityHelper mobility("Sumo/Intersection/fcd.xml");
+ *     mobility.InstallOnDemand([&] (Ptr<Node> node) {
+ *         wifi.Install(wifiPhy, wifiMac, node);
+ *         ndnHelper.Install(node);
+ *       });
+ */
+class TraceReplayMobilityHelper {
+public:
+  typedef std::function<void(Ptr<Node> node)> NodeCallback;
+  typedef std::function<void(Ptr<Node> node, const std::string& vehicle)> VehicleCallback;
+
+  /**
+   * @brief Load SUMO floating car data if @p file ends with .xml (see WaypointTable::LoadFcd),
+   *        or ns-2 movement trace otherwise (see WaypointTable::LoadNs2)
+   * @throw std::runtime_error if the file cannot be read
+   */
+  explicit
+  TraceReplayMobilityHelper(const std::string& file);
+
+  /**
+   * @brief Install TraceReplayMobilityModel on the nodes, i-th node replaying i-th track
+   *
+   * Nodes without a track in the trace and nodes that already have a MobilityModel are skipped.
+   */
+  void
+  Install(const NodeContainer& nodes) const;
+
+  /**
+   * @brief Install TraceReplayMobilityModel on all nodes, the node with id i replaying i-th track
+   */
+  void
+  InstallAll() const;
+
+  /**
+   * @brief Create nodes when vehicles depart and reuse nodes of arrived vehicles
+   *
+   * A single simulator event at a time walks the departures and arrivals of all tracks.  When a
+   * vehicle departs and no parked node is available, a new node with TraceReplayMobilityModel
+   * is created and passed to @p onCreate (e.g., to install devices, NDN stack, and
+   * applications).  When the vehicle arrives, the node is moved to the parking position
+   * (see SetParkingPosition) and waits for the next departing vehicle.
+   *
+   * @p onCreate and @p onDepart are called in a simulator event in the context of the node, so
+   * StackHelper::Install and AppHelper::Install can be used there: they install directly instead
+   * of running a warm-up pass (see StackHelper::IsInNodeContext).
+   *
+   * @param onCreate called once for each created node
+   * @param onDepart called when the node starts to replay a vehicle (optional)
+   * @param onArrive called when the vehicle of the node arrives, before parking (optional)
+   */
+  void
+  InstallOnDemand(const NodeCallback& onCreate, const VehicleCallback& onDepart = nullptr,
+                  const VehicleCallback& onArrive = nullptr) const;
+
+  /**
+   * @brief Set position of nodes without a vehicle in InstallOnDemand, (1e6, 1e6, 0) by default
+   */
+  void
+  SetParkingPosition(const Vector& position);
+
+  shared_ptr<WaypointTable>
+  GetWaypointTable() const
+  {
+    return m_table;
+  }
+
+private:
+  void
+  Install(Ptr<Node> node, uint32_t track) const;
+
+private:
+  shared_ptr<WaypointTable> m_table;
+  Vector m_parkingPosition;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_TRACE_REPLAY_MOBILITY_HELPER_HPP
@@ -30,6 +30,10 @@
 
 #include <ndn-cxx/lp/geo-tag.hpp>
 
+#include "ns3/ndnSIM/model/ndn-position-cache.hpp"
+#include "ns3/ndnSIM/model/ndn-spatial-index.hpp"
+#include "ns3/ndnSIM/utils/ndn-event-trace.hpp"
+
 #include "ns3/mobility-model.h"
 #include "ns3/node-list.h"
 #include "ns3/node.h"
@@ -56,6 +60,7 @@ NFD_LOG_INIT(DirectedGeocastStrategy);
 
 DirectedGeocastStrategy::DirectedGeocastStrategy(Forwarder& forwarder, const Name& name)
   : Strategy(forwarder)
+  , m_timerWheel(ns3::NanoSeconds(100))
 {
   ParsedInstanceName parsed = parseInstanceName(name);
   if (!parsed.parameters.empty()) {
@@ -87,15 +92,8 @@ DirectedGeocastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const
                                               const shared_ptr<pit::Entry>& pitEntry)
 {
   //std::cout<<"Received by "<<ns3::Simulator::GetContext()<<std::endl;
-  double posX =0.0;
-  double posY =0.0;
   ndn::optional<ns3::Vector> pos = getSelfPosition();
-  if(pos) {
-    posX = pos->x;
-    posY = pos->y;
-  }
-  
-  this->onAction(interest.getName(), Received, posX, posY);
+  notifyAction(interest.getName(), Received, pos);
 
   NFD_LOG_DEBUG("ReceivedInterest: ");
   
@@ -114,7 +112,7 @@ DirectedGeocastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const
     if (outFace.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) {
       // for non-ad hoc links, send interest as usual
       this->sendInterest(pitEntry, FaceEndpoint(outFace, 0), interest);
-      this->onAction(interest.getName(), Sent, posX, posY);
+      notifyAction(interest.getName(), Sent, pos);
 
       NFD_LOG_DEBUG(interest << " from=" << ingress << " pitEntry-to=" << outFace.getId());
     }
@@ -128,22 +126,34 @@ DirectedGeocastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const
       PitInfo* pi = pitEntry->insertStrategyInfo<PitInfo>().first;
       if (pi->queue.find(faceId) != pi->queue.end()) {
         NFD_LOG_DEBUG(interest << " already scheduled pitEntry-to=" << outFace.getId());
-        std::cerr << "Impossible point" << std::endl;
+        NDNSIM_TRACE_EVENT("DirectedGeocastStrategy", "AlreadyScheduled", outFace.getId(), 0);
         continue;
       }
 
-      if(shouldLimitTransmission(interest)) {
+      if (!pi->isRegionDecoded) {
+        pi->region = ns3::ndn::GeocastRegion::fromName(interest.getName());
+        pi->isRegionDecoded = true;
+      }
+
+      if(shouldLimitTransmission(interest, pos, pi->region)) {
         NFD_LOG_DEBUG("limiting the transmission of " << interest);
         //std::cerr << "limiting transmission point" << std::endl;
         continue;
       }
 
+      if (!hasUncoveredNeighbors(interest, pos)) {
+        NFD_LOG_DEBUG("no neighbors outside of the previous hop's range, dropping " << interest);
+        NDNSIM_TRACE_EVENT("DirectedGeocastStrategy", "NoUncoveredNeighbors", outFace.getId(), 0);
+        continue;
+      }
+
       // calculate time to delay interest
-      auto delay = calculateDelay(interest);
+      auto delay = calculateDelay(interest, pos);
       NFD_LOG_DEBUG("Delaying by " << delay);
       if (delay > 0_s) {
-        scheduler::ScopedEventId event = getScheduler().schedule(delay, [this, pitEntryWeakPtr,
-                                                                       faceId, interest] {
+        shared_ptr<const Interest> deferredInterest = getSharedInterest(interest);
+        auto timer = m_timerWheel.schedule(ns3::NanoSeconds(delay.count()), [this, pitEntryWeakPtr,
+                                                                            faceId, deferredInterest] {
           auto pitEntry = pitEntryWeakPtr.lock();
           auto outFace = getFaceTable().get(faceId);
           if (pitEntry == nullptr || outFace == nullptr) {
@@ -151,33 +161,19 @@ DirectedGeocastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const
             return;
           }
 
-          this->sendInterest(pitEntry, FaceEndpoint(*outFace, 0), interest);
-          double posX =0.0;
-          double posY =0.0;
-          ndn::optional<ns3::Vector> pos = getSelfPosition();
-          if(pos){
-            posX = pos->x;
-            posY = pos->y;
+          this->sendInterest(pitEntry, FaceEndpoint(*outFace, 0), *deferredInterest);
+          if (!onAction.isEmpty()) {
+            notifyAction(deferredInterest->getName(), Sent, getSelfPosition());
           }
-          //std::cout << x;
-          this->onAction(interest.getName(), Sent, posX, posY);
-          NFD_LOG_DEBUG("delayed " << interest << " pitEntry-to=" << faceId);
+          NFD_LOG_DEBUG("delayed " << *deferredInterest << " pitEntry-to=" << faceId);
         });
 
-        // save `event` into pitEntry
-        pi->queue.emplace(faceId, std::move(event));
+        // save `timer` into pitEntry
+        pi->queue.emplace(faceId, timer);
       }
       else {
         this->sendInterest(pitEntry, FaceEndpoint(outFace, 0), interest);
-        double posX =0.0;
-        double posY =0.0;
-        ndn::optional<ns3::Vector> pos = getSelfPosition();
-        if(pos){
-          posX = pos->x;
-          posY = pos->y;
-        }
-        //std::cout << x;
-        this->onAction(interest.getName(), Sent, posX, posY);
+        notifyAction(interest.getName(), Sent, pos);
 
 
         //this->onAction(interest.getName(), Sent, posx, posy);
@@ -206,14 +202,8 @@ void
 DirectedGeocastStrategy::afterReceiveLoopedInterest(const FaceEndpoint& ingress, const Interest& interest,
                                                     pit::Entry& pitEntry)
 {
-  double posX1 = 0.0;
-  double posY1 = 0.0;
   ndn::optional<ns3::Vector> pos = getSelfPosition();
-  if(pos) {
-    posX1 = pos->x;
-    posY1 = pos->y;
-  }
-  this->onAction(interest.getName(), ReceivedDup, posX1, posY1);
+  notifyAction(interest.getName(), ReceivedDup, pos);
   // determine if interest needs to be cancelled or not
 
   PitInfo* pi = pitEntry.getStrategyInfo<PitInfo>();
@@ -228,9 +218,9 @@ DirectedGeocastStrategy::afterReceiveLoopedInterest(const FaceEndpoint& ingress,
     return;
   }
 
-  if (shouldCancelTransmission(pitEntry, interest)) {
-    item->second.cancel();
-    this->onAction(interest.getName(), Canceled, posX1, posY1);
+  if (shouldCancelTransmission(pitEntry, interest, pos)) {
+    m_timerWheel.cancel(item->second);
+    notifyAction(interest.getName(), Canceled, pos);
 
     // don't do anything to the PIT entry (let it expire as usual)
     NFD_LOG_DEBUG("Canceling transmission of " << interest << " via=" << ingress.face.getId());
@@ -238,20 +228,50 @@ DirectedGeocastStrategy::afterReceiveLoopedInterest(const FaceEndpoint& ingress,
   }
 }
 
+shared_ptr<const Interest>
+DirectedGeocastStrategy::getSharedInterest(const Interest& interest)
+{
+  // Interests decoded by the link service are always owned by shared_ptr
+  try {
+    return interest.shared_from_this();
+  }
+  catch (const std::bad_weak_ptr&) {
+    return make_shared<Interest>(interest);
+  }
+}
+
 ndn::optional<ns3::Vector>
 DirectedGeocastStrategy::getSelfPosition()
 {
-  auto node = ns3::NodeList::GetNode(ns3::Simulator::GetContext());
-  if (node == nullptr) {
-    return nullopt;
+  // strategy instance belongs to a single forwarder, so the node's cache can be resolved once
+  if (m_positionCache == nullptr) {
+    m_positionCache = ns3::ndn::PositionCache::getCurrentPositionCache();
+    if (m_positionCache == nullptr) {
+      return nullopt;
+    }
   }
 
-  auto mobility = node->GetObject<ns3::MobilityModel>();
-  if (mobility == nullptr) {
-    return nullopt;
+  auto pos = m_positionCache->GetPosition();
+  if (pos) {
+    NFD_LOG_DEBUG("self position is: " << *pos);
+  }
+  return pos;
+}
+
+void
+DirectedGeocastStrategy::notifyAction(const Name& name, int action,
+                                      const ndn::optional<ns3::Vector>& self)
+{
+  if (onAction.isEmpty()) {
+    return;
+  }
+
+  if (self) {
+    onAction(name, action, self->x, self->y);
+  }
+  else {
+    onAction(name, action, 0.0, 0.0);
   }
-  NFD_LOG_DEBUG("self position is: " << mobility->GetPosition());
-  return mobility->GetPosition();
 }
 
 ndn::optional<ns3::Vector>
@@ -269,9 +289,9 @@ DirectedGeocastStrategy::extractPositionFromTag(const Interest& interest)
 }
 
 time::nanoseconds
-DirectedGeocastStrategy::calculateDelay(const Interest& interest)
+DirectedGeocastStrategy::calculateDelay(const Interest& interest,
+                                        const ndn::optional<ns3::Vector>& self)
 {
-  auto self = getSelfPosition();
   auto from = extractPositionFromTag(interest);
   //NFD_LOG_DEBUG("the interest is " << interest);
 
@@ -294,9 +314,29 @@ DirectedGeocastStrategy::calculateDelay(const Interest& interest)
 }
 
 bool
-DirectedGeocastStrategy::shouldCancelTransmission(const pit::Entry& oldPitEntry, const Interest& newInterest)
+DirectedGeocastStrategy::hasUncoveredNeighbors(const Interest& interest,
+                                               const ndn::optional<ns3::Vector>& self) const
+{
+  ns3::ndn::SpatialIndex& index = ns3::ndn::SpatialIndex::Get();
+  auto from = extractPositionFromTag(interest);
+  if (index.size() == 0 || !self || !from) {
+    // nothing is known about neighbors, or the Interest comes from the originator
+    return true;
+  }
+
+  for (const auto& neighbor : index.FindInRange(*self, m_range)) {
+    auto pos = neighbor.second->GetObject<ns3::MobilityModel>()->GetPosition();
+    if (CalculateDistance(pos, *from) > m_range) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+DirectedGeocastStrategy::shouldCancelTransmission(const pit::Entry& oldPitEntry, const Interest& newInterest,
+                                                  const ndn::optional<ns3::Vector>& self)
 {
-  auto self = getSelfPosition();
   auto oldFrom = extractPositionFromTag(oldPitEntry.getInterest());
   auto newFrom = extractPositionFromTag(newInterest);
 
@@ -334,29 +374,10 @@ DirectedGeocastStrategy::shouldCancelTransmission(const pit::Entry& oldPitEntry,
   return false;
 }
 
-ndn::optional<ns3::Vector>
-DirectedGeocastStrategy::parsingCoordinate(std::string s)
-{
-  std::string delim = "%2C";
-  double content[3];
-  int i =0;
-  auto start = 0U;
-  auto end = s.find(delim);
-  while (end != std::string::npos){
-    std::string temp = s.substr(start, end-start);
-    start = end + delim.length();
-    end = s.find(delim, start);
-    content[i] = atof(temp.c_str());
-    i++;
-  }
-  content[i] = atof(s.substr(start,end).c_str());
-
-  ndn::optional<ns3::Vector> result = ns3::Vector3D(content[0],content[1],content[2]);
-  return result;
-}
-
 bool
-DirectedGeocastStrategy::shouldLimitTransmission(const Interest& interest)
+DirectedGeocastStrategy::shouldLimitTransmission(const Interest& interest,
+                                                 const ndn::optional<ns3::Vector>& self,
+                                                 const ndn::optional<ns3::ndn::GeocastRegion>& region)
 {
   auto newFrom = extractPositionFromTag(interest);
   if (!newFrom) {
@@ -364,23 +385,18 @@ DirectedGeocastStrategy::shouldLimitTransmission(const Interest& interest)
     return false;
   }
 
-  auto name = interest.getName();
-  std::string limitStr = name.get(-2).toUri();
-  std::string dest = name.get(-3).toUri();
-  std::string src = name.get(-4).toUri();
-  double limit = atof(limitStr.c_str());
-  ndn::optional<ns3::Vector> destination = parsingCoordinate(dest);
-  ndn::optional<ns3::Vector> source = parsingCoordinate(src);
-  auto self = getSelfPosition();
-
-  if (!self || !destination || !source) {
-    NFD_LOG_DEBUG("self, oldFrom, or newFrom position is missing");
+  if (!self || !region) {
+    NFD_LOG_DEBUG("self position or geocast region is missing");
     return false;
   }
 
-  double distSrcDest = CalculateDistance(*source, *destination);
-  double distCurSrc = CalculateDistance(*source, *self);
-  double distCurDest = CalculateDistance(*destination, *self);
+  const ns3::Vector& source = region->source;
+  const ns3::Vector& destination = region->destination;
+  double limit = region->limit;
+
+  double distSrcDest = CalculateDistance(source, destination);
+  double distCurSrc = CalculateDistance(source, *self);
+  double distCurDest = CalculateDistance(destination, *self);
   double cosineAngle = (pow(distCurSrc, 2) - pow(distCurDest, 2) + pow(distSrcDest, 2)) /
                     (2 * distCurSrc * distSrcDest);
   double angle = (acos(cosineAngle)*180)/3.141592;
@@ -394,12 +410,9 @@ DirectedGeocastStrategy::shouldLimitTransmission(const Interest& interest)
 
   // }
 
-  if (ns3::Simulator::GetContext() == 82) {
-    std::cerr << "angle: " << angle << std::endl;
-    std::cerr << *self << ", " << *destination << ", " << *source << std::endl;
-    std::cerr << "srcdest=" << distSrcDest <<
-      ", cursrc=" << distCurSrc << ", curdst=" << distCurDest << ", angle=" << cosineAngle << std::endl;
-  }
+  NFD_LOG_TRACE("self=" << *self << " dst=" << destination << " src=" << source
+                << " srcdest=" << distSrcDest << " cursrc=" << distCurSrc
+                << " curdst=" << distCurDest << " angle=" << angle);
 
   if (isnan(angle) || angle < 0 || angle > 90) {
     // std::cerr << "angle: " << angle << std::endl;
@@ -407,10 +420,12 @@ DirectedGeocastStrategy::shouldLimitTransmission(const Interest& interest)
     // std::cerr << "srcdest=" << distSrcDest <<
     //   ", cursrc=" << distCurSrc << ", curdst=" << distCurDest << ", angle=" << cosineAngle << std::endl;
     NFD_LOG_DEBUG("limiting for angle " << angle);
+    NDNSIM_TRACE_EVENT("DirectedGeocastStrategy", "LimitForAngle", 0, 0);
     return true;
   }
   else if (projection > distSrcDest+limit) {
     NFD_LOG_DEBUG("limiting for distance");
+    NDNSIM_TRACE_EVENT("DirectedGeocastStrategy", "LimitForDistance", 0, 0);
     return true;
   }
 
@@ -26,6 +26,15 @@
 #include "ns3/vector.h"
 #include "ns3/random-variable-stream.h"
 
+#include "ns3/ndnSIM/model/ndn-geocast-region.hpp"
+#include "ns3/ndnSIM/utils/ndn-timer-wheel.hpp"
+
+namespace ns3 {
+namespace ndn {
+class PositionCache;
+} // namespace ndn
+} // namespace ns3
+
 namespace nfd {
 namespace fw {
 
@@ -59,30 +68,56 @@ public:
   static ndn::util::Signal<DirectedGeocastStrategy, Name, int, double, double> onAction;
 
 private:
-  static ndn::optional<ns3::Vector>
+  /**
+   * Position of the node, served from the node-local PositionCache
+   */
+  ndn::optional<ns3::Vector>
   getSelfPosition();
 
   static ndn::optional<ns3::Vector>
   extractPositionFromTag(const Interest& interest);
 
+  /**
+   * Emit onAction at position @p self ((0, 0) if unknown); does nothing if nobody is connected
+   */
+  static void
+  notifyAction(const Name& name, int action, const ndn::optional<ns3::Vector>& self);
+
+  /**
+   * Share ownership of the Interest to defer its transmission, copying it only if necessary
+   */
+  static shared_ptr<const Interest>
+  getSharedInterest(const Interest& interest);
+
 
   /**
    * if returns 0_s, then either own position or geo tag in interest is missing
    */
   time::nanoseconds
-  calculateDelay(const Interest& interest);
+  calculateDelay(const Interest& interest, const ndn::optional<ns3::Vector>& self);
 
   /**
    * will return false if own position is unknown or old PIT entry or new Interest are missing geo tag
    */
   static bool
-  shouldCancelTransmission(const pit::Entry& oldPitEntry, const Interest& newInterest);
-
-  static ndn::optional<ns3::Vector>
-  parsingCoordinate(std::string s);
+  shouldCancelTransmission(const pit::Entry& oldPitEntry, const Interest& newInterest,
+                           const ndn::optional<ns3::Vector>& self);
 
+  /**
+   * will return false if own position or geocast region is unknown, or if the Interest comes
+   * from the originator (no geo tag)
+   */
   static bool
-  shouldLimitTransmission(const Interest& interest);
+  shouldLimitTransmission(const Interest& interest, const ndn::optional<ns3::Vector>& self,
+                          const ndn::optional<ns3::ndn::GeocastRegion>& region);
+
+  /**
+   * will return false only if the global SpatialIndex is populated and every node within range
+   * of this node is also within range of the previous hop, i.e., the rebroadcast would not
+   * reach anybody new.  Returns true if the index is empty or either position is unknown.
+   */
+  bool
+  hasUncoveredNeighbors(const Interest& interest, const ndn::optional<ns3::Vector>& self) const;
 private: // StrategyInfo
   /** \brief StrategyInfo on PIT entry
    */
@@ -96,12 +131,35 @@ private: // StrategyInfo
     }
 
   public:
-    std::map<FaceId, scheduler::ScopedEventId> queue;
+    /** \brief deferred transmissions, per face
+     *
+     *  Timers are not cancelled when the PIT entry is destroyed; the callback only holds a
+     *  weak pointer to the entry and does nothing if it is gone.
+     */
+    std::map<FaceId, ns3::ndn::TimerWheel::TimerId> queue;
+
+    /** \brief geocast region, decoded once from the first Interest of the PIT entry
+     */
+    ndn::optional<ns3::ndn::GeocastRegion> region;
+    bool isRegionDecoded = false;
   };
 
   ns3::Ptr<ns3::UniformRandomVariable> m_randVar;
+  ns3::Ptr<ns3::ndn::PositionCache> m_positionCache;
+
+  /** \brief deferred transmissions of this strategy instance (i.e., of a single forwarder)
+   *
+   *  The resolution is 100 ns, far below the airtime of any frame, so neighbours whose random
+   *  delays differ still fire one after another and can suppress each other, as with the exact
+   *  delays.  The wheel covers 2^24 ticks (1.6 s) before timers are parked.
+   */
+  ns3::ndn::TimerWheel m_timerWheel;
   double m_minTime = 0.02;
   double m_maxTime = 0.1;
+
+  /** \brief transmission range (in meters) assumed for neighbor queries on the SpatialIndex
+   */
+  double m_range = 600;
 };
 
 } // namespace fw
@@ -19,16 +19,11 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,37 +68,67 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/**
+ * @brief Read TLV-TYPE or TLV-LENGTH from @p i, appending raw bytes to @p header
+ * @return number of bytes consumed
+ */
+static size_t
+readVarNumber(ns3::Buffer::Iterator& i, uint8_t* header, uint64_t& number)
+{
+  if (i.GetRemainingSize() < 1) {
+    NDN_THROW(::ndn::tlv::Error("Insufficient data during TLV parsing"));
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t firstOctet = i.ReadU8();
+  header[0] = firstOctet;
+
+  size_t extraOctets = 0;
+  if (firstOctet < 253) {
+    number = firstOctet;
+    return 1;
+  }
+  else if (firstOctet == 253) {
+    extraOctets = 2;
+  }
+  else if (firstOctet == 254) {
+    extraOctets = 4;
+  }
+  else {
+    extraOctets = 8;
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  if (i.GetRemainingSize() < extraOctets) {
+    NDN_THROW(::ndn::tlv::Error("Insufficient data during TLV parsing"));
+  }
+
+  number = 0;
+  for (size_t octet = 1; octet <= extraOctets; ++octet) {
+    header[octet] = i.ReadU8();
+    number = (number << 8) | header[octet];
+  }
+  return 1 + extraOctets;
+}
 
 uint32_t
 BlockHeader::Deserialize(ns3::Buffer::Iterator start)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  // Parse TLV-TYPE and TLV-LENGTH directly from the buffer, then copy TLV-VALUE in one go
+  uint8_t header[2 * 9];
+  uint64_t type = 0;
+  uint64_t length = 0;
+
+  size_t headerSize = readVarNumber(start, header, type);
+  headerSize += readVarNumber(start, header + headerSize, length);
+
+  if (length > start.GetRemainingSize()) {
+    NDN_THROW(::ndn::tlv::Error("TLV-LENGTH exceeds remaining buffer size"));
+  }
+
+  auto buffer = make_shared<::ndn::Buffer>(headerSize + length);
+  std::copy(header, header + headerSize, buffer->begin());
+  start.Read(buffer->data() + headerSize, static_cast<uint32_t>(length));
+
+  m_block = Block(std::move(buffer));
   return m_block.size();
 }
 
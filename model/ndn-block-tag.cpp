@@ -0,0 +1,277 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "ndn-block-tag.hpp"
+
+#include "ndn-block-header.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.BlockTag");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(BlockTag);
+
+namespace {
+
+/**
+ * @brief Blocks referred to by BlockTags that have not been received by all expected receivers
+ *
+ * Identifiers are assigned sequentially, so the oldest blocks come first and expired ones are
+ * purged from the front.
+ */
+class BlockTable
+{
+public:
+  static BlockTable&
+  get()
+  {
+    static BlockTable table;
+    return table;
+  }
+
+  uint64_t
+  add(const Block& block, uint32_t nReceivers)
+  {
+    if (!m_isCleanupScheduled) {
+      // blocks of one simulation run must not be kept into the next one
+      Simulator::ScheduleDestroy(&BlockTable::clear);
+      m_isCleanupScheduled = true;
+    }
+
+    Time now = Simulator::Now();
+    while (!m_blocks.empty() && m_blocks.begin()->second.expireAt <= now) {
+      m_blocks.erase(m_blocks.begin());
+    }
+
+    uint64_t id = m_nextId++;
+    m_blocks.emplace_hint(m_blocks.end(), id, Entry{block, nReceivers, now + m_lifetime});
+    return id;
+  }
+
+  /**
+   * @brief Get block of @p id and count one receiver of it
+   */
+  ::ndn::optional<Block>
+  receive(uint64_t id)
+  {
+    auto it = m_blocks.find(id);
+    if (it == m_blocks.end()) {
+      return ::ndn::nullopt;
+    }
+
+    Block block = it->second.block;
+    if (--it->second.nPending == 0) {
+      m_blocks.erase(it);
+    }
+    return block;
+  }
+
+  void
+  drop(uint64_t id)
+  {
+    auto it = m_blocks.find(id);
+    if (it != m_blocks.end() && --it->second.nPending == 0) {
+      m_blocks.erase(it);
+    }
+  }
+
+  void
+  release(uint64_t id)
+  {
+    m_blocks.erase(id);
+  }
+
+  void
+  setLifetime(Time lifetime)
+  {
+    m_lifetime = lifetime;
+  }
+
+  size_t
+  size() const
+  {
+    return m_blocks.size();
+  }
+
+private:
+  BlockTable()
+    : m_nextId(0)
+    , m_lifetime(Seconds(10))
+    , m_isCleanupScheduled(false)
+  {
+  }
+
+  static void
+  clear()
+  {
+    BlockTable& table = get();
+    table.m_blocks.clear();
+    table.m_isCleanupScheduled = false;
+  }
+
+private:
+  struct Entry
+  {
+    Block block;
+    uint32_t nPending; ///< @brief number of receivers that have not got the block yet
+    Time expireAt;
+  };
+
+  std::map<uint64_t, Entry> m_blocks;
+  uint64_t m_nextId;
+  Time m_lifetime;
+  bool m_isCleanupScheduled;
+};
+
+} // namespace
+
+TypeId
+BlockTag::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::BlockTag")
+    .SetGroupName("Ndn")
+    .SetParent<Tag>()
+    .AddConstructor<BlockTag>()
+    ;
+  return tid;
+}
+
+TypeId
+BlockTag::GetInstanceTypeId() const
+{
+  return GetTypeId();
+}
+
+BlockTag::BlockTag()
+  : m_id(0)
+  , m_hasWire(false)
+{
+}
+
+BlockTag::BlockTag(uint64_t id, bool hasWire)
+  : m_id(id)
+  , m_hasWire(hasWire)
+{
+}
+
+uint32_t
+BlockTag::GetSerializedSize() const
+{
+  return sizeof(m_id) + 1;
+}
+
+void
+BlockTag::Serialize(TagBuffer i) const
+{
+  i.WriteU64(m_id);
+  i.WriteU8(m_hasWire);
+}
+
+void
+BlockTag::Deserialize(TagBuffer i)
+{
+  m_id = i.ReadU64();
+  m_hasWire = i.ReadU8() != 0;
+}
+
+void
+BlockTag::Print(std::ostream& os) const
+{
+  os << "BlockTag " << m_id << (m_hasWire ? " (with wire)" : "");
+}
+
+Ptr<ns3::Packet>
+BlockTag::CreatePacket(const Block& block, uint32_t nReceivers)
+{
+  NS_ASSERT(nReceivers > 0);
+
+  Ptr<ns3::Packet> packet;
+  bool hasWire = nReceivers > 1;
+  if (hasWire) {
+    packet = Create<ns3::Packet>();
+    packet->AddHeader(BlockHeader(nfdFace::Transport::Packet(Block(block))));
+  }
+  else {
+    packet = Create<ns3::Packet>(block.size());
+  }
+  packet->AddPacketTag(BlockTag(BlockTable::get().add(block, nReceivers), hasWire));
+  return packet;
+}
+
+::ndn::optional<Block>
+BlockTag::GetBlock(const ns3::Packet& packet)
+{
+  BlockTag tag;
+  bool hasTag = packet.PeekPacketTag(tag);
+  if (hasTag) {
+    auto block = BlockTable::get().receive(tag.m_id);
+    if (block) {
+      return block;
+    }
+    if (!tag.m_hasWire) {
+      NS_LOG_WARN("Block " << tag.m_id << " has been released before delivery");
+      return ::ndn::nullopt;
+    }
+    NS_LOG_DEBUG("Block " << tag.m_id << " has been released, using the wire encoding");
+  }
+
+  // header is parsed in place, no need to copy the packet
+  BlockHeader header;
+  packet.PeekHeader(header);
+  return std::move(header.getBlock());
+}
+
+void
+BlockTag::Drop(const ns3::Packet& packet)
+{
+  BlockTag tag;
+  if (packet.PeekPacketTag(tag)) {
+    BlockTable::get().drop(tag.m_id);
+  }
+}
+
+void
+BlockTag::Release(const ns3::Packet& packet)
+{
+  BlockTag tag;
+  if (packet.PeekPacketTag(tag)) {
+    BlockTable::get().release(tag.m_id);
+  }
+}
+
+void
+BlockTag::SetLifetime(Time lifetime)
+{
+  BlockTable::get().setLifetime(lifetime);
+}
+
+size_t
+BlockTag::GetNBlocks()
+{
+  return BlockTable::get().size();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#ifndef NDNSIM_NDN_BLOCK_TAG_HPP
+#define NDNSIM_NDN_BLOCK_TAG_HPP
+
+#include "ns3/tag.h"
+#include "ns3/packet.h"
+#include "ns3/nstime.h"
+
+#include "ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Packet tag referring to the wire encoding of an NDN packet kept in simulator memory
+ *
+ * In pointer-passing mode (see NetDeviceTransport::SetPointerPassing), the ns-3 packet carries
+ * this tag, which only holds an identifier of the Block kept in a simulator-wide table, so
+ * receivers get the Block without serialization, copying or re-parsing.
+ *
+ * The block is released as soon as all expected receivers got it (see GetBlock and Drop).
+ * A packet for a single receiver (point-to-point link) carries a virtual (zero-filled, not
+ * allocated) payload of the size of the encoded NDN packet, so PHY and MAC timing is exactly the
+ * same as with BlockHeader.  A packet for several receivers also carries the wire encoding,
+ * because some neighbors of a broadcast may never get the packet and its block may be released
+ * before others do; these receivers fall back to the wire encoding.  Blocks of packets dropped
+ * by a device in pointer-passing mode are released right away (see
+ * NetDeviceTransport::SetPointerPassing); blocks lost without any trace (e.g., broadcasts that
+ * some neighbors never hear) are released after a lifetime.
+ */
+class BlockTag : public Tag {
+public:
+  static TypeId
+  GetTypeId();
+
+  virtual TypeId
+  GetInstanceTypeId() const;
+
+  BlockTag();
+
+  BlockTag(uint64_t id, bool hasWire);
+
+  virtual uint32_t
+  GetSerializedSize() const;
+
+  virtual void
+  Serialize(TagBuffer i) const;
+
+  virtual void
+  Deserialize(TagBuffer i);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+  /**
+   * @brief Create ns-3 packet referring to @p block through the tag
+   * @param block wire encoding of NDN packet
+   * @param nReceivers number of devices expected to receive the packet
+   *
+   * The payload is virtual if @p nReceivers is 1, otherwise it is the wire encoding of @p block
+   * as serialized by BlockHeader.
+   */
+  static Ptr<ns3::Packet>
+  CreatePacket(const Block& block, uint32_t nReceivers = 1);
+
+  /**
+   * @brief Get block carried by @p packet, counting one receiver of the block
+   * @return the block referred to by the tag of @p packet, or decoded from its wire encoding if
+   *         @p packet has no BlockTag or the block has already been released; nullopt if the
+   *         block has been released and the payload is virtual
+   */
+  static ::ndn::optional<Block>
+  GetBlock(const ns3::Packet& packet);
+
+  /**
+   * @brief Count one receiver of the block carried by @p packet that dropped the packet
+   */
+  static void
+  Drop(const ns3::Packet& packet);
+
+  /**
+   * @brief Release the block carried by @p packet, e.g., when the packet could not be sent
+   */
+  static void
+  Release(const ns3::Packet& packet);
+
+  /**
+   * @brief Set how long blocks are kept after sending if not all receivers got them,
+   *        10 seconds by default
+   */
+  static void
+  SetLifetime(Time lifetime);
+
+  /**
+   * @brief Get number of blocks that are kept for receivers that have not got them yet
+   */
+  static size_t
+  GetNBlocks();
+
+private:
+  uint64_t m_id;
+  bool m_hasWire;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_BLOCK_TAG_HPP
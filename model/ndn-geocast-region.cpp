@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-geocast-region.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t GeocastRegion::NAME_COMPONENT_TYPE = 200;
+
+static const size_t N_ENCODED_VALUES = 7;
+static const size_t ENCODED_SIZE = N_ENCODED_VALUES * sizeof(uint64_t);
+
+GeocastRegion::GeocastRegion(const Vector& source, const Vector& destination, double limit)
+  : source(source)
+  , destination(destination)
+  , limit(limit)
+{
+}
+
+name::Component
+GeocastRegion::toNameComponent() const
+{
+  const double values[N_ENCODED_VALUES] = {source.x, source.y, source.z,
+                                           destination.x, destination.y, destination.z,
+                                           limit};
+
+  uint8_t buffer[ENCODED_SIZE];
+  for (size_t i = 0; i < N_ENCODED_VALUES; ++i) {
+    uint64_t bits;
+    std::memcpy(&bits, &values[i], sizeof(bits));
+    boost::endian::native_to_big_inplace(bits);
+    std::memcpy(buffer + i * sizeof(bits), &bits, sizeof(bits));
+  }
+
+  return name::Component(NAME_COMPONENT_TYPE, buffer, sizeof(buffer));
+}
+
+::ndn::optional<GeocastRegion>
+GeocastRegion::fromNameComponent(const name::Component& component)
+{
+  if (component.type() != NAME_COMPONENT_TYPE || component.value_size() != ENCODED_SIZE) {
+    return ::ndn::nullopt;
+  }
+
+  double values[N_ENCODED_VALUES];
+  for (size_t i = 0; i < N_ENCODED_VALUES; ++i) {
+    uint64_t bits;
+    std::memcpy(&bits, component.value() + i * sizeof(bits), sizeof(bits));
+    boost::endian::big_to_native_inplace(bits);
+    std::memcpy(&values[i], &bits, sizeof(bits));
+  }
+
+  return GeocastRegion(Vector(values[0], values[1], values[2]),
+                       Vector(values[3], values[4], values[5]),
+                       values[6]);
+}
+
+/**
+ * @brief Parse up to @p nValues comma-separated decimal numbers from the component value
+ * @return true only if exactly @p nValues numbers were parsed and the whole value consumed
+ */
+static bool
+parseLegacyComponent(const name::Component& component, double* values, size_t nValues)
+{
+  char buffer[128];
+  if (component.value_size() == 0 || component.value_size() >= sizeof(buffer)) {
+    return false;
+  }
+  std::memcpy(buffer, component.value(), component.value_size());
+  buffer[component.value_size()] = '\0';
+
+  const char* pos = buffer;
+  for (size_t i = 0; i < nValues; ++i) {
+    char* end = nullptr;
+    values[i] = std::strtod(pos, &end);
+    if (end == pos) {
+      return false;
+    }
+    pos = end;
+
+    if (i + 1 < nValues) {
+      if (*pos != ',') {
+        return false;
+      }
+      ++pos;
+    }
+  }
+  return *pos == '\0';
+}
+
+/**
+ * @brief Decode region from the three "x,y,z/x,y,z/limit" components ending at @p last
+ */
+static ::ndn::optional<GeocastRegion>
+parseLegacyComponents(const Name& name, ssize_t last)
+{
+  if (name.size() < static_cast<size_t>(3 - last)) {
+    return ::ndn::nullopt;
+  }
+
+  double src[3];
+  double dst[3];
+  double limit;
+  if (!parseLegacyComponent(name.get(last - 2), src, 3) ||
+      !parseLegacyComponent(name.get(last - 1), dst, 3) ||
+      !parseLegacyComponent(name.get(last), &limit, 1)) {
+    return ::ndn::nullopt;
+  }
+
+  return GeocastRegion(Vector(src[0], src[1], src[2]), Vector(dst[0], dst[1], dst[2]), limit);
+}
+
+::ndn::optional<GeocastRegion>
+GeocastRegion::fromName(const Name& name)
+{
+  for (const auto& component : name) {
+    if (component.type() == NAME_COMPONENT_TYPE) {
+      return fromNameComponent(component);
+    }
+  }
+
+  // compatibility: /<prefix>/<src>/<dst>/<limit>/<seq>
+  return parseLegacyComponents(name, -2);
+}
+
+Name
+GeocastRegion::toTypedPrefix(const Name& prefix)
+{
+  // /<prefix>/<src>/<dst>/<limit>
+  auto region = parseLegacyComponents(prefix, -1);
+  if (!region) {
+    return prefix;
+  }
+
+  return prefix.getPrefix(-3).append(region->toNameComponent());
+}
+
+std::ostream&
+operator<<(std::ostream& os, const GeocastRegion& region)
+{
+  return os << "src=" << region.source << " dst=" << region.destination
+            << " limit=" << region.limit;
+}
+
+} // namespace ndn
+} // namespace ns3
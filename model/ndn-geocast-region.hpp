@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_MODEL_NDN_GEOCAST_REGION_HPP
+#define NDNSIM_MODEL_NDN_GEOCAST_REGION_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/vector.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Geocast region: corridor from source to destination point, extended by a limit
+ *
+ * The region is carried in the Interest name as a single typed name component
+ * (TLV-TYPE GeocastRegion::NAME_COMPONENT_TYPE) whose TLV-VALUE is seven big-endian IEEE 754
+ * doubles: source x, y, z, destination x, y, z, and limit.
+ *
+ * For compatibility, decoding also accepts the older convention of three generic name
+ * components preceding the last (sequence number) component:
+ *
+ *     /<prefix>/<srcX>,<srcY>,<srcZ>/<dstX>,<dstY>,<dstZ>/<limit>/<seq>
+ */
+class GeocastRegion {
+public:
+  /**
+   * @brief TLV-TYPE of the name component carrying the encoded region
+   */
+  static const uint32_t NAME_COMPONENT_TYPE;
+
+  GeocastRegion() = default;
+
+  GeocastRegion(const Vector& source, const Vector& destination, double limit);
+
+  /**
+   * @brief Encode region as a typed name component
+   */
+  name::Component
+  toNameComponent() const;
+
+  /**
+   * @brief Decode region from the typed name component
+   * @return nullopt if @p component is not a valid geocast region component
+   */
+  static ::ndn::optional<GeocastRegion>
+  fromNameComponent(const name::Component& component);
+
+  /**
+   * @brief Decode region from Interest name
+   *
+   * Looks for the typed name component first and falls back to the older
+   * "x,y,z/x,y,z/limit" convention.
+   *
+   * @return nullopt if the name does not carry a well-formed region
+   */
+  static ::ndn::optional<GeocastRegion>
+  fromName(const Name& name);
+
+  /**
+   * @brief Convert Interest prefix ending with the older "x,y,z/x,y,z/limit" convention to
+   *        the typed name component
+   *
+   * For example, /v2safety/8thStreet/0,0,0/700,0,0/100 becomes /v2safety/8thStreet/<region>.
+   *
+   * @return @p prefix unchanged if it does not end with a well-formed region
+   */
+  static Name
+  toTypedPrefix(const Name& prefix);
+
+public:
+  Vector source;
+  Vector destination;
+  double limit = 0;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const GeocastRegion& region);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_MODEL_NDN_GEOCAST_REGION_HPP
@@ -28,13 +28,20 @@
 #include "ns3/object-vector.h"
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
+#include "ns3/channel.h"
+#include "ns3/point-to-point-channel.h"
 
 #include "ndn-net-device-transport.hpp"
+#include "ndn-lte-ue-net-device-transport.hpp"
 
 #include "../helper/ndn-stack-helper.hpp"
 
 #include <boost/property_tree/info_parser.hpp>
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/internal-face.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/internal-transport.hpp"
@@ -109,10 +116,15 @@ L3Protocol::GetTypeId(void)
   return tid;
 }
 
-class L3Protocol::Impl {
-private:
-  Impl()
-  {
+/**
+ * Initial NFD config, parsed only once and shared by L3Protocols until modified
+ */
+static const shared_ptr<const nfd::ConfigSection>&
+getInitialConfig()
+{
+  static shared_ptr<const nfd::ConfigSection> config = [] {
+    auto config = make_shared<nfd::ConfigSection>();
+
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
       "general\n"
@@ -163,11 +175,34 @@ private:
       "\n";
 
     std::istringstream input(initialConfig);
-    boost::property_tree::read_info(input, m_config);
+    boost::property_tree::read_info(input, *config);
+    return config;
+  }();
+
+  return config;
+}
+
+class L3Protocol::Impl {
+private:
+  Impl()
+    : m_config(getInitialConfig())
+    , m_isManagementEnabled(true)
+  {
   }
 
   friend class L3Protocol;
 
+  // Face indexes are declared before the forwarder, so they outlive FaceTable signal handlers
+  struct IndexedFace
+  {
+    const NetDevice* netDevice;
+    const Node* neighbor; ///< other end of point-to-point channel, if any
+  };
+  std::unordered_map<const NetDevice*, nfd::Face*> m_facesByNetDevice;
+  std::unordered_multimap<const Node*, nfd::Face*> m_facesByNeighbor;
+  std::unordered_map<const nfd::Face*, IndexedFace> m_indexedFaces;
+  std::unordered_set<nfd::Face*> m_tracedFaces; ///< faces added with addFace
+
   // note that shared_ptr needed for Python bindings
 
   std::shared_ptr<::nfd::Forwarder> m_forwarder;
@@ -190,13 +225,33 @@ private:
   std::shared_ptr<::ndn::Face> m_internalRibClientFace;
   std::unique_ptr<::nfd::rib::Service> m_ribService;
 
-  nfd::ConfigSection m_config;
+  shared_ptr<const nfd::ConfigSection> m_config;
+  shared_ptr<nfd::ConfigSection> m_ownConfig; ///< m_config, if modified through getConfig
+  bool m_isManagementEnabled;
 
   PolicyCreationCallback m_policy;
 };
 
 L3Protocol::L3Protocol()
   : m_impl(new Impl())
+  , m_inInterests(*this, [] (const FaceTracedCallback<Interest>& trace, Face& face) {
+      face.afterReceiveInterest.connect(trace.makeSlot(face));
+    })
+  , m_outInterests(*this, [] (const FaceTracedCallback<Interest>& trace, Face& face) {
+      face.getLinkService()->afterSendInterest.connect(trace.makeSlot(face));
+    })
+  , m_outData(*this, [] (const FaceTracedCallback<Data>& trace, Face& face) {
+      face.getLinkService()->afterSendData.connect(trace.makeSlot(face));
+    })
+  , m_inData(*this, [] (const FaceTracedCallback<Data>& trace, Face& face) {
+      face.afterReceiveData.connect(trace.makeSlot(face));
+    })
+  , m_outNack(*this, [] (const FaceTracedCallback<lp::Nack>& trace, Face& face) {
+      face.getLinkService()->afterSendNack.connect(trace.makeSlot(face));
+    })
+  , m_inNack(*this, [] (const FaceTracedCallback<lp::Nack>& trace, Face& face) {
+      face.afterReceiveNack.connect(trace.makeSlot(face));
+    })
 {
   NS_LOG_FUNCTION(this);
 }
@@ -212,12 +267,28 @@ L3Protocol::initialize()
   m_impl->m_forwarder = make_shared<::nfd::Forwarder>();
 
   ::nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
+  faceTable.afterAdd.connect([this] (Face& face) { indexFace(face); });
+  faceTable.beforeRemove.connect([this] (Face& face) {
+      if (m_impl == nullptr) {
+        return; // faces are removed while m_impl is being destroyed in DoDispose
+      }
+      unindexFace(face);
+      m_impl->m_tracedFaces.erase(&face);
+    });
+
   faceTable.addReserved(::nfd::face::makeNullFace(), ::nfd::face::FACEID_NULL);
   // faceTable.addReserved(face::makeNullFace(FaceUri("contentstore://")), face::FACEID_CONTENT_STORE);
-  m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(faceTable, nullptr);
 
-  initializeManagement();
-  initializeRibManager();
+  m_impl->m_isManagementEnabled = !m_impl->m_config->get<bool>("ndnSIM.minimal_stack", false);
+  if (isManagementEnabled()) {
+    m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(faceTable, nullptr);
+
+    initializeManagement();
+    initializeRibManager();
+  }
+  else {
+    initializeTables();
+  }
 
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
@@ -247,9 +318,17 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  NS_ASSERT_MSG(m_impl->m_internalClientFaceForInjects != nullptr,
+                "Cannot inject Interests: NFD management is disabled on this node (minimal stack)");
   m_impl->m_internalClientFaceForInjects->expressInterest(interest, nullptr, nullptr, nullptr);
 }
 
+bool
+L3Protocol::isManagementEnabled() const
+{
+  return m_impl->m_isManagementEnabled;
+}
+
 void
 L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
 {
@@ -271,7 +350,7 @@ L3Protocol::initializeManagement()
   m_impl->m_dispatcher = make_unique<::ndn::mgmt::Dispatcher>(*m_impl->m_internalClientFace, StackHelper::getKeyChain());
   m_impl->m_authenticator = ::nfd::CommandAuthenticator::create();
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_forwarder_status_manager", false)) {
+  if (!m_impl->m_config->get<bool>("ndnSIM.disable_forwarder_status_manager", false)) {
     m_impl->m_forwarderStatusManager = make_unique<::nfd::ForwarderStatusManager>(*m_impl->m_forwarder, *m_impl->m_dispatcher);
   }
   m_impl->m_faceManager = make_unique<::nfd::FaceManager>(*m_impl->m_faceSystem, *m_impl->m_dispatcher, *m_impl->m_authenticator);
@@ -279,12 +358,13 @@ L3Protocol::initializeManagement()
                                                         *m_impl->m_dispatcher, *m_impl->m_authenticator);
   m_impl->m_csManager = make_unique<::nfd::CsManager>(m_impl->m_forwarder->getCs(), m_impl->m_forwarder->getCounters(),
                                                       *m_impl->m_dispatcher, *m_impl->m_authenticator);
-  if (!this->getConfig().get<bool>("ndnSIM.disable_strategy_choice_manager", false)) {
+  if (!m_impl->m_config->get<bool>("ndnSIM.disable_strategy_choice_manager", false)) {
     m_impl->m_strategyChoiceManager = make_unique<::nfd::StrategyChoiceManager>(m_impl->m_forwarder->getStrategyChoice(),
                                                                                 *m_impl->m_dispatcher, *m_impl->m_authenticator);
 
   }
-  else {
+  else if (m_impl->m_config->get_child("authorizations.authorize.privileges")
+             .count("strategy-choice") > 0) {
     this->getConfig().get_child("authorizations").get_child("authorize").get_child("privileges").erase("strategy-choice");
   }
 
@@ -302,7 +382,7 @@ L3Protocol::initializeManagement()
   // }
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(*m_impl->m_config, false, "ndnSIM.conf");
 
   tablesConfig.ensureConfigured();
 
@@ -312,6 +392,24 @@ L3Protocol::initializeManagement()
   m_impl->m_dispatcher->addTopPrefix(topPrefix, false);
 }
 
+void
+L3Protocol::initializeTables()
+{
+  using namespace nfd;
+
+  // only "tables" section is processed, everything else belongs to management and RIB
+  ConfigFile config(&ConfigFile::ignoreUnknownSection);
+
+  m_impl->m_forwarder->getCs().setPolicy(m_impl->m_policy());
+
+  TablesConfigSection tablesConfig(*m_impl->m_forwarder);
+  tablesConfig.setConfigFile(config);
+
+  config.parse(*m_impl->m_config, false, "ndnSIM.conf");
+
+  tablesConfig.ensureConfigured();
+}
+
 void
 L3Protocol::initializeRibManager()
 {
@@ -320,7 +418,7 @@ L3Protocol::initializeRibManager()
   std::tie(m_impl->m_internalRibFace, m_impl->m_internalRibClientFace) = face::makeInternalFace(StackHelper::getKeyChain());
   m_impl->m_forwarder->getFaceTable().add(m_impl->m_internalRibFace);
 
-  m_impl->m_ribService = make_unique<rib::Service>(m_impl->m_config,
+  m_impl->m_ribService = make_unique<rib::Service>(*m_impl->m_config,
                                                    std::ref(*m_impl->m_internalRibClientFace),
                                                    std::ref(StackHelper::getKeyChain()));
 }
@@ -340,19 +438,40 @@ L3Protocol::getFibManager()
 nfd::StrategyChoiceManager&
 L3Protocol::getStrategyChoiceManager()
 {
+  NS_ASSERT_MSG(m_impl->m_strategyChoiceManager != nullptr, "StrategyChoiceManager is disabled");
   return *m_impl->m_strategyChoiceManager;
 }
 
 ::nfd::rib::Service&
 L3Protocol::getRibService()
 {
+  NS_ASSERT_MSG(m_impl->m_ribService != nullptr, "RIB service is disabled (minimal stack)");
   return *m_impl->m_ribService;
 }
 
+shared_ptr<const nfd::ConfigSection>
+L3Protocol::getDefaultConfig()
+{
+  return getInitialConfig();
+}
+
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
-  return m_impl->m_config;
+  if (m_impl->m_ownConfig == nullptr) {
+    // copy on first modification, the config may be shared with other nodes
+    m_impl->m_ownConfig = make_shared<nfd::ConfigSection>(*m_impl->m_config);
+    m_impl->m_config = m_impl->m_ownConfig;
+  }
+  return *m_impl->m_ownConfig;
+}
+
+void
+L3Protocol::setConfig(shared_ptr<const nfd::ConfigSection> config)
+{
+  NS_ASSERT(config != nullptr);
+  m_impl->m_config = std::move(config);
+  m_impl->m_ownConfig = nullptr;
 }
 
 /*
@@ -394,74 +513,111 @@ L3Protocol::addFace(shared_ptr<Face> face)
 
   m_impl->m_forwarder->addFace(face);
 
-  std::weak_ptr<Face> weakFace = face;
+  // signals of the face are connected only to the trace sources that have sinks, the rest are
+  // connected when they get one
+  m_impl->m_tracedFaces.insert(face.get());
+  m_inInterests.hookup(*face);
+  m_outInterests.hookup(*face);
+  m_inData.hookup(*face);
+  m_outData.hookup(*face);
+  m_inNack.hookup(*face);
+  m_outNack.hookup(*face);
 
-  // // Connect Signals to TraceSource
-  face->afterReceiveInterest.connect([this, weakFace](const Interest& interest) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_inInterests(interest, *face);
-      }
-    });
-
-  face->afterReceiveData.connect([this, weakFace](const Data& data) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_inData(data, *face);
-      }
-    });
+  return face->getId();
+}
 
-  face->afterReceiveNack.connect([this, weakFace](const lp::Nack& nack) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_inNack(nack, *face);
-      }
-    });
+void
+L3Protocol::forEachTracedFace(const std::function<void(Face&)>& f) const
+{
+  for (Face* face : m_impl->m_tracedFaces) {
+    f(*face);
+  }
+}
 
-  auto tracingLink = face->getLinkService();
-  NS_LOG_LOGIC("Adding trace sources for afterSendInterest and afterSendData");
-  tracingLink->afterSendInterest.connect([this, weakFace](const Interest& interest) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_outInterests(interest, *face);
-      }
-    });
+shared_ptr<Face>
+L3Protocol::getFaceById(nfd::FaceId id) const
+{
+  return m_impl->m_forwarder->getFaceTable().get(id)->shared_from_this();
+}
 
-  tracingLink->afterSendData.connect([this, weakFace](const Data& data) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_outData(data, *face);
-      }
-    });
+void
+L3Protocol::indexFace(Face& face)
+{
+  Ptr<NetDevice> netDevice;
+  if (auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport())) {
+    netDevice = transport->GetNetDevice();
+  }
+  else if (auto transport = dynamic_cast<LteUeNetDeviceTransport*>(face.getTransport())) {
+    netDevice = transport->GetNetDevice();
+  }
+  if (netDevice == nullptr) {
+    return;
+  }
 
-  tracingLink->afterSendNack.connect([this, weakFace](const lp::Nack& nack) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_outNack(nack, *face);
-      }
-    });
+  const Node* neighbor = nullptr;
+  Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel>(netDevice->GetChannel());
+  if (channel != nullptr && channel->GetNDevices() == 2) {
+    Ptr<NetDevice> otherSide = channel->GetDevice(0);
+    if (otherSide == netDevice) {
+      otherSide = channel->GetDevice(1);
+    }
+    neighbor = PeekPointer(otherSide->GetNode());
+  }
 
-  return face->getId();
+  m_impl->m_indexedFaces[&face] = {PeekPointer(netDevice), neighbor};
+  m_impl->m_facesByNetDevice[PeekPointer(netDevice)] = &face;
+  if (neighbor != nullptr) {
+    m_impl->m_facesByNeighbor.emplace(neighbor, &face);
+  }
 }
 
-shared_ptr<Face>
-L3Protocol::getFaceById(nfd::FaceId id) const
+void
+L3Protocol::unindexFace(Face& face)
 {
-  return m_impl->m_forwarder->getFaceTable().get(id)->shared_from_this();
+  auto indexed = m_impl->m_indexedFaces.find(&face);
+  if (indexed == m_impl->m_indexedFaces.end()) {
+    return;
+  }
+
+  auto byNetDevice = m_impl->m_facesByNetDevice.find(indexed->second.netDevice);
+  if (byNetDevice != m_impl->m_facesByNetDevice.end() && byNetDevice->second == &face) {
+    m_impl->m_facesByNetDevice.erase(byNetDevice);
+  }
+
+  auto byNeighbor = m_impl->m_facesByNeighbor.equal_range(indexed->second.neighbor);
+  for (auto i = byNeighbor.first; i != byNeighbor.second; ++i) {
+    if (i->second == &face) {
+      m_impl->m_facesByNeighbor.erase(i);
+      break;
+    }
+  }
+
+  m_impl->m_indexedFaces.erase(indexed);
 }
 
 shared_ptr<Face>
 L3Protocol::getFaceByNetDevice(Ptr<NetDevice> netDevice) const
 {
-  for (auto& i : m_impl->m_forwarder->getFaceTable()) {
-    auto transport = dynamic_cast<NetDeviceTransport*>(i.getTransport());
-    if (transport == nullptr)
-      continue;
+  auto i = m_impl->m_facesByNetDevice.find(PeekPointer(netDevice));
+  if (i == m_impl->m_facesByNetDevice.end()) {
+    return nullptr;
+  }
+  return i->second->shared_from_this();
+}
 
-    if (transport->GetNetDevice() == netDevice)
-      return i.shared_from_this();
+std::vector<shared_ptr<Face>>
+L3Protocol::getFacesByNeighbor(Ptr<Node> neighbor) const
+{
+  std::vector<shared_ptr<Face>> faces;
+  auto range = m_impl->m_facesByNeighbor.equal_range(PeekPointer(neighbor));
+  for (auto i = range.first; i != range.second; ++i) {
+    faces.push_back(i->second->shared_from_this());
   }
-  return nullptr;
+
+  std::sort(faces.begin(), faces.end(), [] (const shared_ptr<Face>& a, const shared_ptr<Face>& b) {
+      return a->getId() < b->getId();
+    });
+  return faces;
 }
 
 Ptr<L3Protocol>
@@ -22,6 +22,7 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include <functional>
 #include <list>
 #include <vector>
 
@@ -104,8 +105,21 @@ public:
   shared_ptr<nfd::Forwarder>
   getForwarder();
 
+  /**
+   * \brief Check whether NFD management (managers and RIB service) is running on the node
+   *
+   * Management is disabled when the stack is installed in minimal mode
+   * (StackHelper::enableMinimalStack).  In this mode, command Interests cannot be processed and
+   * helpers update forwarder tables directly.  The result is determined when the stack is
+   * initialized.
+   */
+  bool
+  isManagementEnabled() const;
+
   /**
    * \brief Get smart pointer to nfd::FibManager, used by node's NFD
+   *
+   * \return nullptr if management is disabled
    */
   shared_ptr<nfd::FibManager>
   getFibManager();
@@ -146,16 +160,50 @@ public:
 
   /**
    * \brief Get face for NetDevice
+   *
+   * Faces with NetDevice-based transports are indexed when they are added to the FaceTable and
+   * removed from the index when they are closed, so the lookup does not depend on the number
+   * of faces on the node.
+   *
+   * \return nullptr if there is no face for the NetDevice
    */
   shared_ptr<Face>
   getFaceByNetDevice(Ptr<NetDevice> netDevice) const;
 
   /**
-   * \brief Get NFD config (boost::property_tree)
+   * \brief Get faces of the point-to-point links to @p neighbor
+   *
+   * Faces are indexed by the node on the other end of their PointToPointChannel; faces on
+   * other channel types are never returned.
+   *
+   * \return faces of all links to the neighbor, sorted by FaceId (empty if not connected)
+   */
+  std::vector<shared_ptr<Face>>
+  getFacesByNeighbor(Ptr<Node> neighbor) const;
+
+  /**
+   * \brief Get NFD config that L3Protocol starts with
+   */
+  static shared_ptr<const nfd::ConfigSection>
+  getDefaultConfig();
+
+  /**
+   * \brief Get NFD config (boost::property_tree) for modification
+   *
+   * The config is shared with other nodes until this method is called for the first time, which
+   * makes a private copy.  Changes take effect only before the stack is initialized.
    */
   nfd::ConfigSection&
   getConfig();
 
+  /**
+   * \brief Use @p config, which may be shared with other nodes, as NFD config
+   *
+   * Must be called before the stack is initialized.
+   */
+  void
+  setConfig(shared_ptr<const nfd::ConfigSection> config);
+
   /**
    * \brief Inject interest through internal Face
    */
@@ -204,6 +252,103 @@ private:
   void
   initializeRibManager();
 
+  void
+  initializeTables();
+
+  void
+  indexFace(Face& face);
+
+  void
+  unindexFace(Face& face);
+
+  /**
+   * @brief Call @p f for every face added with addFace
+   */
+  void
+  forEachTracedFace(const std::function<void(Face&)>& f) const;
+
+private:
+  /**
+   * @brief Trace source of per-face packets, connected to the signals of faces only once it
+   *        gets its first sink
+   *
+   * Until then, packets of the faces do not go through the trace source at all.
+   */
+  template<typename Packet>
+  class FaceTracedCallback : public TracedCallback<const Packet&, const Face&>
+  {
+  public:
+    /**
+     * @brief Connect the signal of @p face reported by @p trace
+     */
+    typedef void (*Hookup)(const FaceTracedCallback& trace, Face& face);
+
+    FaceTracedCallback(const L3Protocol& l3, Hookup hookup)
+      : m_l3(l3)
+      , m_hookup(hookup)
+      , m_isActive(false)
+    {
+    }
+
+    /**
+     * @brief Make a slot for a signal of @p face that fires the trace source
+     *
+     * The slot holds @p face only weakly, and does nothing once the face is gone.
+     */
+    std::function<void(const Packet&)>
+    makeSlot(Face& face) const
+    {
+      std::weak_ptr<Face> weakFace = face.shared_from_this();
+      return [this, weakFace] (const Packet& packet) {
+        shared_ptr<Face> face = weakFace.lock();
+        if (face != nullptr) {
+          (*this)(packet, *face);
+        }
+      };
+    }
+
+    /**
+     * @brief Connect the newly added @p face, if the trace source has sinks
+     */
+    void
+    hookup(Face& face) const
+    {
+      if (m_isActive) {
+        m_hookup(*this, face);
+      }
+    }
+
+    void
+    ConnectWithoutContext(const CallbackBase& callback)
+    {
+      TracedCallback<const Packet&, const Face&>::ConnectWithoutContext(callback);
+      activate();
+    }
+
+    void
+    Connect(const CallbackBase& callback, std::string path)
+    {
+      TracedCallback<const Packet&, const Face&>::Connect(callback, path);
+      activate();
+    }
+
+  private:
+    void
+    activate()
+    {
+      if (m_isActive) {
+        return;
+      }
+      m_isActive = true;
+      m_l3.forEachTracedFace([this] (Face& face) { m_hookup(*this, face); });
+    }
+
+  private:
+    const L3Protocol& m_l3;
+    Hookup m_hookup;
+    bool m_isActive;
+  };
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -211,16 +356,14 @@ private:
   // These objects are aggregated, but for optimization, get them here
   Ptr<Node> m_node; ///< \brief node on which ndn stack is installed
 
-  TracedCallback<const Interest&, const Face&>
-    m_inInterests; ///< @brief trace of incoming Interests
-  TracedCallback<const Interest&, const Face&>
-    m_outInterests; ///< @brief Transmitted interests trace
+  FaceTracedCallback<Interest> m_inInterests;  ///< @brief trace of incoming Interests
+  FaceTracedCallback<Interest> m_outInterests; ///< @brief Transmitted interests trace
 
-  TracedCallback<const Data&, const Face&> m_outData; ///< @brief trace of outgoing Data
-  TracedCallback<const Data&, const Face&> m_inData;  ///< @brief trace of incoming Data
+  FaceTracedCallback<Data> m_outData; ///< @brief trace of outgoing Data
+  FaceTracedCallback<Data> m_inData;  ///< @brief trace of incoming Data
 
-  TracedCallback<const lp::Nack&, const Face&> m_outNack; ///< @brief trace of outgoing Nack
-  TracedCallback<const lp::Nack&, const Face&> m_inNack;  ///< @brief trace of incoming Nack
+  FaceTracedCallback<lp::Nack> m_outNack; ///< @brief trace of outgoing Nack
+  FaceTracedCallback<lp::Nack> m_inNack;  ///< @brief trace of incoming Nack
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
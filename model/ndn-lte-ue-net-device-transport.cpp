@@ -28,13 +28,17 @@
 #include <ndn-cxx/data.hpp>
 
 #include "ns3/queue.h"
-#include "ns3/udp-socket-factory.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-l3-protocol.h"
 
 NS_LOG_COMPONENT_DEFINE("ndn.LteUeNetDeviceTransport");
 
 namespace ns3 {
 namespace ndn {
 
+const char* LteUeNetDeviceTransport::GROUP_ADDRESS = "225.63.63.1";
+const uint8_t LteUeNetDeviceTransport::IP_PROTOCOL_NUMBER = 253;
+
 LteUeNetDeviceTransport::LteUeNetDeviceTransport(Ptr<Node> node,
                                                  const Ptr<NetDevice>& netDevice,
                                                  const std::string& localUri,
@@ -42,7 +46,8 @@ LteUeNetDeviceTransport::LteUeNetDeviceTransport(Ptr<Node> node,
                                                  ::ndn::nfd::FaceScope scope,
                                                  ::ndn::nfd::FacePersistency persistency,
                                                  ::ndn::nfd::LinkType linkType)
-  : m_netDevice(netDevice)
+  : m_groupAddress(GROUP_ADDRESS)
+  , m_netDevice(netDevice)
   , m_node(node)
 {
   this->setLocalUri(FaceUri(localUri));
@@ -50,7 +55,7 @@ LteUeNetDeviceTransport::LteUeNetDeviceTransport(Ptr<Node> node,
   this->setScope(scope);
   this->setPersistency(persistency);
   this->setLinkType(linkType);
-  this->setMtu(m_netDevice->GetMtu()); // Use the MTU of the netDevice
+  this->setMtu(m_netDevice->GetMtu() - m_ipHeader.GetSerializedSize()); // MTU of the netDevice minus IPv4 header
 
   // // Get send queue capacity for congestion marking
   // PointerValue txQueueAttribute;
@@ -73,13 +78,17 @@ LteUeNetDeviceTransport::LteUeNetDeviceTransport(Ptr<Node> node,
 
   NS_ASSERT_MSG(m_netDevice != 0, "NetDeviceFace needs to be assigned a valid NetDevice");
 
-  m_socket = Socket::CreateSocket(m_node, UdpSocketFactory::GetTypeId());
-  m_socket->Bind(InetSocketAddress(Ipv4Address::GetAny (), 6363));
-  m_socket->Connect(InetSocketAddress(Ipv4Address("225.63.63.1"), 6363));
-  m_socket->Listen ();
-  m_socket->SetAllowBroadcast(true);
-
-  m_socket->SetRecvCallback(MakeCallback(&LteUeNetDeviceTransport::receiveFromSocket, this));
+  m_ipHeader.SetDestination(m_groupAddress);
+  m_ipHeader.SetProtocol(IP_PROTOCOL_NUMBER);
+  m_ipHeader.SetTtl(1);
+  m_ipHeader.SetDontFragment();
+  updateSourceAddress();
+
+  // LteUeNetDevice delivers everything it receives as IPv4 (or IPv6); NDN packets are picked by
+  // the IPv4 protocol number.  Ipv4L3Protocol receives them as well, routes them, and drops them
+  // in LocalDeliver as it has no such L4 protocol
+  m_node->RegisterProtocolHandler(MakeCallback(&LteUeNetDeviceTransport::receiveFromNetDevice, this),
+                                  Ipv4L3Protocol::PROT_NUMBER, m_netDevice);
 }
 
 LteUeNetDeviceTransport::~LteUeNetDeviceTransport()
@@ -122,25 +131,57 @@ LteUeNetDeviceTransport::doSend(Packet&& packet)
   Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
   ns3Packet->AddHeader(header);
 
+  if (m_ipHeader.GetSource() == Ipv4Address::GetAny()) {
+    // address could have been assigned after the face was created
+    updateSourceAddress();
+  }
+  m_ipHeader.SetPayloadSize(ns3Packet->GetSize());
+  ns3Packet->AddHeader(m_ipHeader);
+
   // send the NS3 packet
-  m_socket->Send(ns3Packet);
+  m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(), Ipv4L3Protocol::PROT_NUMBER);
 }
 
 // callback
 void
-LteUeNetDeviceTransport::receiveFromSocket(Ptr<Socket> socket)
+LteUeNetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
+                                              Ptr<const ns3::Packet> p,
+                                              uint16_t protocol,
+                                              const Address& from, const Address& to,
+                                              NetDevice::PacketType packetType)
 {
-  Ptr<ns3::Packet> p;
-  while ((p = socket->Recv())) {
-    // Convert NS3 packet to NFD packet
-    Ptr<ns3::Packet> packet = p->Copy();
+  NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
+
+  Ipv4Header ipHeader;
+  p->PeekHeader(ipHeader);
+  if (ipHeader.GetProtocol() != IP_PROTOCOL_NUMBER || ipHeader.GetDestination() != m_groupAddress) {
+    return; // regular IP traffic
+  }
+
+  // Copy only duplicates packet metadata, the buffer is shared
+  Ptr<ns3::Packet> packet = p->Copy();
+  packet->RemoveHeader(ipHeader);
 
-    BlockHeader header;
-    packet->RemoveHeader(header);
+  // Convert NS3 packet to NFD packet
+  BlockHeader header;
+  packet->PeekHeader(header);
 
-    auto nfdPacket = Packet(std::move(header.getBlock()));
+  auto nfdPacket = Packet(std::move(header.getBlock()));
+
+  this->receive(std::move(nfdPacket));
+}
+
+void
+LteUeNetDeviceTransport::updateSourceAddress()
+{
+  Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
+  if (ipv4 == nullptr) {
+    return;
+  }
 
-    this->receive(std::move(nfdPacket));
+  int32_t interface = ipv4->GetInterfaceForDevice(m_netDevice);
+  if (interface >= 0 && ipv4->GetNAddresses(interface) > 0) {
+    m_ipHeader.SetSource(ipv4->GetAddress(interface, 0).GetLocal());
   }
 }
 
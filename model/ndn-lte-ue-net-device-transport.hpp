@@ -29,20 +29,40 @@
 #include "ns3/node.h"
 #include "ns3/pointer.h"
 
-#include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
-#include "ns3/socket.h"
+#include "ns3/ipv4-header.h"
 
 namespace ns3 {
 namespace ndn {
 
 /**
  * \ingroup ndn-face
- * \brief ndnSIM-specific transport
+ * \brief ndnSIM-specific transport for LTE sidelink
+ *
+ * NDN packets are handed directly to LteUeNetDevice, prefixed only with a pre-built IPv4 header
+ * (destination GROUP_ADDRESS, protocol IP_PROTOCOL_NUMBER) that the sidelink TFT classifier
+ * needs to select the bearer.  Received packets are taken from the device through an L2
+ * protocol handler for the IPv4 ethertype, the same way NetDeviceTransport does, so the UDP
+ * layer, sockets, and per-packet socket address tags are skipped.
+ *
+ * IPv4 processing is not skipped: LteUeNetDevice accepts only IPv4/IPv6 payloads and passes
+ * every received packet to all IPv4 handlers of the node, so each NDN packet also goes through
+ * Ipv4L3Protocol::Receive (header checks and route lookup) before LocalDeliver drops it for the
+ * lack of an L4 protocol with IP_PROTOCOL_NUMBER.
  */
 class LteUeNetDeviceTransport : public nfd::face::Transport
 {
 public:
+  /**
+   * \brief Multicast group address of the sidelink bearer (must match LteSlTft of the scenario)
+   */
+  static const char* GROUP_ADDRESS;
+
+  /**
+   * \brief IP protocol number identifying NDN payload (value reserved for experimentation, RFC 3692)
+   */
+  static const uint8_t IP_PROTOCOL_NUMBER;
+
   LteUeNetDeviceTransport(Ptr<Node> node, const Ptr<NetDevice>& netDevice,
                           const std::string& localUri,
                           const std::string& remoteUri,
@@ -66,9 +86,17 @@ private:
   doSend(Packet&& packet) override;
 
   void
-  receiveFromSocket(Ptr<Socket> socket);
+  receiveFromNetDevice(Ptr<NetDevice> device,
+                       Ptr<const ns3::Packet> p,
+                       uint16_t protocol,
+                       const Address& from, const Address& to,
+                       NetDevice::PacketType packetType);
+
+  void
+  updateSourceAddress();
 
-  Ptr<Socket> m_socket;
+  Ipv4Address m_groupAddress;
+  Ipv4Header m_ipHeader; ///< \brief Template of IPv4 header prepended to every outgoing packet
 
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
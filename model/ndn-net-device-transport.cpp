@@ -21,6 +21,7 @@
 
 #include "../helper/ndn-stack-helper.hpp"
 #include "ndn-block-header.hpp"
+#include "ndn-block-tag.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
@@ -43,6 +44,7 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        ::ndn::nfd::LinkType linkType)
   : m_netDevice(netDevice)
   , m_node(node)
+  , m_isPointerPassing(false)
 {
   this->setLocalUri(FaceUri(localUri));
   this->setRemoteUri(FaceUri(remoteUri));
@@ -52,20 +54,8 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
   this->setMtu(m_netDevice->GetMtu()); // Use the MTU of the netDevice
 
   // Get send queue capacity for congestion marking
-  PointerValue txQueueAttribute;
-  if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
-    Ptr<ns3::QueueBase> txQueue = txQueueAttribute.Get<ns3::QueueBase>();
-    // must be put into bytes mode queue
-
-    auto size = txQueue->GetMaxSize();
-    if (size.GetUnit() == BYTES) {
-      this->setSendQueueCapacity(size.GetValue());
-    }
-    else {
-      // don't know the exact size in bytes, guessing based on "standard" packet size
-      this->setSendQueueCapacity(size.GetValue() * 1500);
-    }
-  }
+  m_p2pDevice = DynamicCast<PointToPointNetDevice>(m_netDevice);
+  RefreshTxQueue();
 
   NS_LOG_FUNCTION(this << "Creating an ndnSIM transport instance for netDevice with URI"
                   << this->getLocalUri());
@@ -80,14 +70,52 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
 NetDeviceTransport::~NetDeviceTransport()
 {
   NS_LOG_FUNCTION_NOARGS();
+
+  SetPointerPassing(false);
+}
+
+Ptr<ns3::QueueBase>
+NetDeviceTransport::GetTxQueue()
+{
+  if (m_p2pDevice != nullptr && m_p2pDevice->GetQueue() != m_txQueue) {
+    RefreshTxQueue();
+  }
+  return m_txQueue;
+}
+
+void
+NetDeviceTransport::RefreshTxQueue()
+{
+  PointerValue txQueueAttribute;
+  if (!m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
+    NS_LOG_INFO(m_netDevice->GetInstanceTypeId().GetName()
+                << " has no TxQueue attribute, send queue length is not available");
+    m_txQueue = nullptr;
+    return;
+  }
+  m_txQueue = txQueueAttribute.Get<ns3::QueueBase>();
+  if (m_txQueue == nullptr) {
+    NS_LOG_INFO(m_netDevice->GetInstanceTypeId().GetName()
+                << " has no transmit queue set, send queue length is not available");
+    return;
+  }
+
+  // must be put into bytes mode queue
+  auto size = m_txQueue->GetMaxSize();
+  if (size.GetUnit() == BYTES) {
+    this->setSendQueueCapacity(size.GetValue());
+  }
+  else {
+    // don't know the exact size in bytes, guessing based on "standard" packet size
+    this->setSendQueueCapacity(size.GetValue() * 1500);
+  }
 }
 
 ssize_t
 NetDeviceTransport::getSendQueueLength()
 {
-  PointerValue txQueueAttribute;
-  if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
-    Ptr<ns3::QueueBase> txQueue = txQueueAttribute.Get<ns3::QueueBase>();
+  Ptr<ns3::QueueBase> txQueue = GetTxQueue();
+  if (txQueue != nullptr) {
     return txQueue->GetNBytes();
   }
   else {
@@ -111,15 +139,29 @@ NetDeviceTransport::doSend(Packet&& packet)
   NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                   << this->getLocalUri());
 
-  // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
+  Ptr<ns3::Packet> ns3Packet;
+  if (m_isPointerPassing) {
+    // every other device on a shared channel (e.g., CSMA or wireless) may receive the packet
+    Ptr<Channel> channel = m_netDevice->GetChannel();
+    uint32_t nReceivers = 1;
+    if (channel != nullptr && channel->GetNDevices() > 2) {
+      nReceivers = channel->GetNDevices() - 1;
+    }
+    ns3Packet = BlockTag::CreatePacket(packet.packet, nReceivers);
+  }
+  else {
+    // convert NFD packet to NS3 packet
+    BlockHeader header(packet);
 
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+    ns3Packet = Create<ns3::Packet>();
+    ns3Packet->AddHeader(header);
+  }
 
   // send the NS3 packet
-  m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
-                    L3Protocol::ETHERNET_FRAME_TYPE);
+  if (!m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
+                         L3Protocol::ETHERNET_FRAME_TYPE)) {
+    BlockTag::Release(*ns3Packet);
+  }
 }
 
 // callback
@@ -132,15 +174,44 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
+  // packets sent in pointer-passing mode refer to their block, others are decoded
+  auto block = BlockTag::GetBlock(*p);
+  if (!block) {
+    return;
+  }
 
-  BlockHeader header;
-  packet->RemoveHeader(header);
+  this->receive(Packet(std::move(*block)));
+}
 
-  auto nfdPacket = Packet(std::move(header.getBlock()));
+void
+NetDeviceTransport::dropFromNetDevice(Ptr<const ns3::Packet> p)
+{
+  BlockTag::Drop(*p);
+}
 
-  this->receive(std::move(nfdPacket));
+void
+NetDeviceTransport::releaseFromNetDevice(Ptr<const ns3::Packet> p)
+{
+  BlockTag::Release(*p);
+}
+
+void
+NetDeviceTransport::connectDropTraces(bool isConnected)
+{
+  // Blocks of pointer-passing packets are released as soon as the device drops them, without
+  // waiting for their lifetime.  Devices that lack some of these trace sources ignore them.
+  auto rxDrop = MakeCallback(&NetDeviceTransport::dropFromNetDevice, this);
+  auto txDrop = MakeCallback(&NetDeviceTransport::releaseFromNetDevice, this);
+  if (isConnected) {
+    m_netDevice->TraceConnectWithoutContext("PhyRxDrop", rxDrop);
+    m_netDevice->TraceConnectWithoutContext("MacTxDrop", txDrop);
+    m_netDevice->TraceConnectWithoutContext("PhyTxDrop", txDrop);
+  }
+  else {
+    m_netDevice->TraceDisconnectWithoutContext("PhyRxDrop", rxDrop);
+    m_netDevice->TraceDisconnectWithoutContext("MacTxDrop", txDrop);
+    m_netDevice->TraceDisconnectWithoutContext("PhyTxDrop", txDrop);
+  }
 }
 
 Ptr<NetDevice>
@@ -149,5 +220,16 @@ NetDeviceTransport::GetNetDevice() const
   return m_netDevice;
 }
 
+void
+NetDeviceTransport::SetPointerPassing(bool isEnabled)
+{
+  if (isEnabled == m_isPointerPassing) {
+    return;
+  }
+
+  m_isPointerPassing = isEnabled;
+  connectDropTraces(isEnabled);
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -54,6 +54,49 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /**
+   * \brief Enable or disable pointer-passing mode
+   *
+   * The transport passes the encoded NDN packet in memory via BlockTag.  On point-to-point links,
+   * packets are not serialized and carry a virtual payload of the same size; on shared channels,
+   * they also carry the wire encoding.  Receivers accept all forms regardless of their own mode.
+   * Disabled by default.
+   *
+   * Payload bytes of packets on point-to-point links are zeros, so packet captures (e.g., pcap)
+   * do not show these NDN packets.
+   *
+   * While enabled, the transport follows drop traces of the NetDevice (PhyRxDrop, MacTxDrop and
+   * PhyTxDrop, if present) to release blocks of dropped packets right away.
+   */
+  void
+  SetPointerPassing(bool isEnabled);
+
+  /**
+   * \brief Get transmit queue of the NetDevice, if the device has one
+   *
+   * The queue is looked up once and cached.  For PointToPointNetDevice, a queue replaced
+   * with SetQueue is picked up automatically; for other devices, call RefreshTxQueue after
+   * replacing the "TxQueue" attribute.
+   *
+   * Only devices that expose their queue as a "TxQueue" attribute (e.g., PointToPointNetDevice
+   * and CsmaNetDevice) are supported.  Devices that queue packets internally (e.g., WifiNetDevice
+   * and LteNetDevice) have no such queue: for their faces, the send queue length is unknown,
+   * congestion marking does not apply, and no occupancy is traced.
+   *
+   * \return the queue, or nullptr if the device has no "TxQueue" attribute
+   */
+  Ptr<ns3::QueueBase>
+  GetTxQueue();
+
+  /**
+   * \brief Look up transmit queue of the NetDevice again and update send queue capacity
+   *
+   * If the device has no "TxQueue" attribute, the transport is left without a queue (see
+   * GetTxQueue).
+   */
+  void
+  RefreshTxQueue();
+
   virtual ssize_t
   getSendQueueLength() final;
 
@@ -71,8 +114,21 @@ private:
                        const Address& from, const Address& to,
                        NetDevice::PacketType packetType);
 
+  void
+  dropFromNetDevice(Ptr<const ns3::Packet> p);
+
+  void
+  releaseFromNetDevice(Ptr<const ns3::Packet> p);
+
+  void
+  connectDropTraces(bool isConnected);
+
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+  bool m_isPointerPassing;
+
+  Ptr<PointToPointNetDevice> m_p2pDevice; ///< \brief NetDevice, if it is a PointToPointNetDevice
+  Ptr<ns3::QueueBase> m_txQueue;          ///< \brief cached transmit queue of NetDevice
 };
 
 } // namespace ndn
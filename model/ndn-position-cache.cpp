@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-position-cache.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/mobility-model.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.PositionCache");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(PositionCache);
+
+TypeId
+PositionCache::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::PositionCache")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<PositionCache>()
+
+      .AddAttribute("TimeQuantum",
+                    "Maximum age of the cached position (zero: reuse only within the same timestamp)",
+                    TimeValue(Seconds(0)), MakeTimeAccessor(&PositionCache::m_timeQuantum),
+                    MakeTimeChecker());
+  return tid;
+}
+
+PositionCache::PositionCache()
+  : m_isValid(false)
+{
+}
+
+void
+PositionCache::DoDispose()
+{
+  m_mobility = nullptr;
+  m_isValid = false;
+
+  Object::DoDispose();
+}
+
+bool
+PositionCache::resolveMobility()
+{
+  if (m_mobility != nullptr) {
+    return true;
+  }
+
+  m_mobility = GetObject<MobilityModel>();
+  if (m_mobility == nullptr) {
+    return false;
+  }
+
+  m_mobility->TraceConnectWithoutContext("CourseChange",
+                                         MakeCallback(&PositionCache::courseChanged, this));
+  return true;
+}
+
+::ndn::optional<Vector>
+PositionCache::GetPosition()
+{
+  if (!resolveMobility()) {
+    return ::ndn::nullopt;
+  }
+
+  Time now = Simulator::Now();
+  if (!m_isValid || now - m_lastUpdate > m_timeQuantum) {
+    m_position = m_mobility->GetPosition();
+    m_lastUpdate = now;
+    m_isValid = true;
+    NS_LOG_DEBUG("Position updated to " << m_position);
+  }
+
+  return m_position;
+}
+
+void
+PositionCache::Invalidate()
+{
+  m_isValid = false;
+}
+
+void
+PositionCache::courseChanged(Ptr<const MobilityModel> model)
+{
+  Invalidate();
+}
+
+Ptr<PositionCache>
+PositionCache::getPositionCache(Ptr<Node> node)
+{
+  Ptr<PositionCache> cache = node->GetObject<PositionCache>();
+  if (cache == nullptr) {
+    cache = CreateObject<PositionCache>();
+    node->AggregateObject(cache);
+  }
+  return cache;
+}
+
+Ptr<PositionCache>
+PositionCache::getCurrentPositionCache()
+{
+  uint32_t context = Simulator::GetContext();
+  if (context == Simulator::NO_CONTEXT || context >= NodeList::GetNNodes()) {
+    return nullptr;
+  }
+
+  return getPositionCache(NodeList::GetNode(context));
+}
+
+} // namespace ndn
+} // namespace ns3
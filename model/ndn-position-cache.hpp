@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_MODEL_NDN_POSITION_CACHE_HPP
+#define NDNSIM_MODEL_NDN_POSITION_CACHE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+class Node;
+class MobilityModel;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Node-local cache of the node's own position
+ *
+ * The cache is aggregated to the node and is shared by everything on the node that needs the
+ * current position (e.g., DirectedGeocastStrategy and GeoTag generation in the link service).
+ * A cached position is reused until either the mobility model fires CourseChange or the
+ * position becomes older than TimeQuantum.  With the default TimeQuantum of zero, position is
+ * recomputed at most once per simulation timestamp, i.e., results are exactly the same as
+ * querying MobilityModel directly.
+ *
+ * MobilityModel is resolved lazily, so the cache works even if the mobility model is aggregated
+ * after the NDN stack is installed.
+ */
+class PositionCache : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  PositionCache();
+
+  /**
+   * @brief Get (cached) position of the node, or nullopt if node does not have a MobilityModel
+   */
+  ::ndn::optional<Vector>
+  GetPosition();
+
+  /**
+   * @brief Force recalculation of the position on the next GetPosition call
+   */
+  void
+  Invalidate();
+
+  /**
+   * @brief Get the position cache aggregated to @p node, aggregating a new one if necessary
+   */
+  static Ptr<PositionCache>
+  getPositionCache(Ptr<Node> node);
+
+  /**
+   * @brief Get the position cache of the node in the current simulation context
+   * @return nullptr if called outside of a node context
+   */
+  static Ptr<PositionCache>
+  getCurrentPositionCache();
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  void
+  courseChanged(Ptr<const MobilityModel> model);
+
+  bool
+  resolveMobility();
+
+private:
+  Time m_timeQuantum;
+
+  Ptr<MobilityModel> m_mobility;
+  bool m_isValid;
+  Time m_lastUpdate;
+  Vector m_position;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_MODEL_NDN_POSITION_CACHE_HPP
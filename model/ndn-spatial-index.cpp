@@ -0,0 +1,339 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-spatial-index.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/mobility-model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SpatialIndex");
+
+namespace ns3 {
+namespace ndn {
+
+static const double DEFAULT_CELL_SIZE = 100.0;
+static const Time DEFAULT_REBIN_INTERVAL = Seconds(1);
+
+SpatialIndex&
+SpatialIndex::Get()
+{
+  static SpatialIndex instance;
+  return instance;
+}
+
+SpatialIndex::SpatialIndex()
+  : m_cellSize(DEFAULT_CELL_SIZE)
+  , m_rebinInterval(DEFAULT_REBIN_INTERVAL)
+  , m_nIndexed(0)
+  , m_maxSpeed(0)
+{
+}
+
+void
+SpatialIndex::clear()
+{
+  SpatialIndex& index = Get();
+  index.m_cellSize = DEFAULT_CELL_SIZE;
+  index.m_rebinInterval = DEFAULT_REBIN_INTERVAL;
+  index.m_entries.clear();
+  index.m_nIndexed = 0;
+  index.m_cells.clear();
+  index.m_moving.clear();
+  index.m_maxSpeed = 0;
+  index.m_lastRebin = Time();
+}
+
+void
+SpatialIndex::SetCellSize(double cellSize)
+{
+  NS_ASSERT(cellSize > 0);
+  m_cellSize = cellSize;
+
+  m_cells.clear();
+  for (uint32_t id = 0; id < m_entries.size(); ++id) {
+    Entry& entry = m_entries[id];
+    if (entry.isIndexed) {
+      entry.cell = getCell(entry.mobility->GetPosition());
+      insertIntoCell(id, entry.cell);
+    }
+  }
+}
+
+void
+SpatialIndex::SetRebinInterval(Time interval)
+{
+  m_rebinInterval = interval;
+}
+
+size_t
+SpatialIndex::size() const
+{
+  return m_nIndexed;
+}
+
+int64_t
+SpatialIndex::getCell(int32_t x, int32_t y) const
+{
+  return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+}
+
+int32_t
+SpatialIndex::getCoordinate(double value) const
+{
+  // far away (or non-finite) positions share the outermost cells, results are still exact as
+  // candidates are filtered by distance
+  double coordinate = std::floor(value / m_cellSize);
+  if (coordinate >= std::numeric_limits<int32_t>::max()) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  if (!(coordinate > std::numeric_limits<int32_t>::min())) {
+    return std::numeric_limits<int32_t>::min();
+  }
+  return static_cast<int32_t>(coordinate);
+}
+
+int64_t
+SpatialIndex::getCell(const Vector& pos) const
+{
+  return getCell(getCoordinate(pos.x), getCoordinate(pos.y));
+}
+
+void
+SpatialIndex::insertIntoCell(uint32_t nodeId, int64_t cell)
+{
+  m_cells[cell].push_back(nodeId);
+}
+
+void
+SpatialIndex::removeFromCell(uint32_t nodeId, int64_t cell)
+{
+  auto found = m_cells.find(cell);
+  if (found == m_cells.end()) {
+    return;
+  }
+
+  auto& ids = found->second;
+  auto item = std::find(ids.begin(), ids.end(), nodeId);
+  if (item != ids.end()) {
+    *item = ids.back();
+    ids.pop_back();
+  }
+  if (ids.empty()) {
+    m_cells.erase(found);
+  }
+}
+
+void
+SpatialIndex::Install(Ptr<Node> node)
+{
+  Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+  if (mobility == nullptr) {
+    NS_LOG_DEBUG("Node " << node->GetId() << " does not have a MobilityModel, ignoring");
+    return;
+  }
+
+  uint32_t id = node->GetId();
+  if (id >= m_entries.size()) {
+    m_entries.resize(id + 1);
+  }
+
+  Entry& entry = m_entries[id];
+  if (entry.isIndexed) {
+    return;
+  }
+
+  entry.node = node;
+  entry.mobility = mobility;
+  entry.cell = getCell(mobility->GetPosition());
+  entry.isIndexed = true;
+  ++m_nIndexed;
+  insertIntoCell(id, entry.cell);
+
+  mobility->TraceConnectWithoutContext("CourseChange",
+                                       MakeBoundCallback(&SpatialIndex::courseChanged, id));
+  update(id);
+}
+
+void
+SpatialIndex::Install(const NodeContainer& c)
+{
+  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+    Install(*i);
+  }
+}
+
+void
+SpatialIndex::InstallAll()
+{
+  Install(NodeContainer::GetGlobal());
+}
+
+void
+SpatialIndex::courseChanged(uint32_t nodeId, Ptr<const MobilityModel> model)
+{
+  SpatialIndex& index = Get();
+  if (nodeId < index.m_entries.size() && index.m_entries[nodeId].isIndexed) {
+    index.update(nodeId);
+  }
+}
+
+void
+SpatialIndex::update(uint32_t nodeId)
+{
+  Entry& entry = m_entries[nodeId];
+
+  int64_t cell = getCell(entry.mobility->GetPosition());
+  if (cell != entry.cell) {
+    removeFromCell(nodeId, entry.cell);
+    insertIntoCell(nodeId, cell);
+    entry.cell = cell;
+  }
+
+  double speed = entry.mobility->GetVelocity().GetLength();
+  if (speed > 0) {
+    m_moving.insert(nodeId);
+    m_maxSpeed = std::max(m_maxSpeed, speed);
+  }
+  else {
+    m_moving.erase(nodeId);
+  }
+}
+
+void
+SpatialIndex::rebinIfNeeded()
+{
+  if (m_moving.empty()) {
+    m_maxSpeed = 0;
+    m_lastRebin = Simulator::Now();
+    return;
+  }
+
+  if (Simulator::Now() - m_lastRebin >= m_rebinInterval) {
+    rebinAll();
+  }
+}
+
+void
+SpatialIndex::rebinAll()
+{
+  NS_LOG_FUNCTION(this << m_moving.size());
+
+  m_maxSpeed = 0;
+  // update() may remove stopped nodes from m_moving, so iterate over a copy
+  std::vector<uint32_t> moving(m_moving.begin(), m_moving.end());
+  for (uint32_t id : moving) {
+    update(id);
+  }
+  m_lastRebin = Simulator::Now();
+}
+
+SpatialIndex::NodeDistanceList
+SpatialIndex::FindInRange(const Vector& center, double radius)
+{
+  rebinIfNeeded();
+
+  NodeDistanceList result;
+
+  // nodes may have drifted from their cell since the last re-binning
+  double slack = m_maxSpeed * (Simulator::Now() - m_lastRebin).GetSeconds();
+  double searchRadius = radius + slack;
+
+  auto checkCell = [&] (const std::vector<uint32_t>& ids) {
+    for (uint32_t id : ids) {
+      const Entry& entry = m_entries[id];
+      double distance = CalculateDistance(center, entry.mobility->GetPosition());
+      if (distance <= radius) {
+        result.emplace_back(distance, entry.node);
+      }
+    }
+  };
+
+  // 64-bit, so that iteration up to the maximum 32-bit coordinate does not overflow
+  int64_t minX = getCoordinate(center.x - searchRadius);
+  int64_t maxX = getCoordinate(center.x + searchRadius);
+  int64_t minY = getCoordinate(center.y - searchRadius);
+  int64_t maxY = getCoordinate(center.y + searchRadius);
+
+  if (static_cast<double>(maxX - minX + 1) * (maxY - minY + 1) > m_cells.size()) {
+    // query area covers more cells than are occupied, walk occupied cells instead
+    for (const auto& cell : m_cells) {
+      checkCell(cell.second);
+    }
+  }
+  else {
+    for (int64_t x = minX; x <= maxX; ++x) {
+      for (int64_t y = minY; y <= maxY; ++y) {
+        auto cell = m_cells.find(getCell(static_cast<int32_t>(x), static_cast<int32_t>(y)));
+        if (cell != m_cells.end()) {
+          checkCell(cell->second);
+        }
+      }
+    }
+  }
+
+  std::sort(result.begin(), result.end(),
+            [] (const NodeDistanceList::value_type& a, const NodeDistanceList::value_type& b) {
+              return a.first < b.first;
+            });
+  return result;
+}
+
+SpatialIndex::NodeDistanceList
+SpatialIndex::FindNearest(const Vector& center, size_t k)
+{
+  NodeDistanceList result;
+  if (k == 0 || m_nIndexed == 0) {
+    return result;
+  }
+
+  // expand the search radius until enough nodes are found or all nodes are covered.  Once the
+  // searched square has more cells than are occupied, FindInRange walks all occupied cells
+  // anyway, so the last round is not limited by radius.  Nodes at non-finite distance (e.g.,
+  // NaN position) are never found, so the loop must not rely on finding all nodes.
+  double radius = m_cellSize;
+  while (true) {
+    result = FindInRange(center, radius);
+    if (result.size() >= k || result.size() == m_nIndexed || std::isinf(radius)) {
+      break;
+    }
+
+    double side = 2 * radius / m_cellSize + 1;
+    if (side * side > m_cells.size()) {
+      radius = std::numeric_limits<double>::infinity();
+    }
+    else {
+      radius *= 2;
+    }
+  }
+
+  if (result.size() > k) {
+    result.resize(k);
+  }
+  return result;
+}
+
+} // namespace ndn
+} // namespace ns3
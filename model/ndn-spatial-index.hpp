@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_MODEL_NDN_SPATIAL_INDEX_HPP
+#define NDNSIM_MODEL_NDN_SPATIAL_INDEX_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+#include "ns3/node-container.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+class MobilityModel;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Global uniform-grid index over node positions
+ *
+ * The index answers "which nodes are within R of X" and "which K nodes are closest to X"
+ * without scanning every node.  It is updated incrementally from MobilityModel's CourseChange
+ * trace.  Nodes that move between course changes (e.g., ConstantVelocityMobilityModel) are
+ * re-binned lazily at most once per RebinInterval; in between, queries widen the searched area
+ * by the distance the fastest node could have travelled and then filter candidates by their
+ * exact current position, so results are always exact.
+ *
+ * Once populated, the index is also used by DirectedGeocastStrategy to skip rebroadcasts that
+ * would not reach any node outside the previous hop's range.
+ *
+ * Example:
+ *
+ *     ndn::SpatialIndex::Get().Install(ueNodes);
+ *     ...
+ *     auto neighbors = ndn::SpatialIndex::Get().FindInRange(pos, 300);
+ */
+class SpatialIndex : boost::noncopyable {
+public:
+  typedef std::vector<std::pair<double, Ptr<Node>>> NodeDistanceList;
+
+  /**
+   * @brief Get the global instance
+   */
+  static SpatialIndex&
+  Get();
+
+  /**
+   * @brief Remove all nodes from the index and reset parameters to default
+   */
+  static void
+  clear();
+
+  /**
+   * @brief Set size of the grid cell (in meters)
+   *
+   * Ideally, the size should be comparable to the radius of typical range queries (e.g.,
+   * transmission range).  Changing the cell size re-bins all indexed nodes.
+   */
+  void
+  SetCellSize(double cellSize);
+
+  /**
+   * @brief Set maximum interval between re-binning of nodes moving without course changes
+   */
+  void
+  SetRebinInterval(Time interval);
+
+  /**
+   * @brief Add node to the index
+   *
+   * Node must have a MobilityModel aggregated, otherwise it is ignored
+   */
+  void
+  Install(Ptr<Node> node);
+
+  /**
+   * @brief Add all nodes in the container to the index
+   */
+  void
+  Install(const NodeContainer& c);
+
+  /**
+   * @brief Add all nodes in the simulation to the index
+   */
+  void
+  InstallAll();
+
+  /**
+   * @brief Get number of nodes in the index
+   */
+  size_t
+  size() const;
+
+  /**
+   * @brief Find all nodes within @p radius of @p center
+   * @return list of (distance, node) pairs, sorted by distance
+   */
+  NodeDistanceList
+  FindInRange(const Vector& center, double radius);
+
+  /**
+   * @brief Find up to @p k nodes closest to @p center
+   * @return list of (distance, node) pairs, sorted by distance
+   */
+  NodeDistanceList
+  FindNearest(const Vector& center, size_t k);
+
+private:
+  SpatialIndex();
+
+  struct Entry
+  {
+    Ptr<Node> node;
+    Ptr<MobilityModel> mobility;
+    int64_t cell = 0;
+    bool isIndexed = false;
+  };
+
+  /**
+   * @brief Get grid coordinate of @p value, clamped to the 32-bit range
+   */
+  int32_t
+  getCoordinate(double value) const;
+
+  int64_t
+  getCell(const Vector& pos) const;
+
+  int64_t
+  getCell(int32_t x, int32_t y) const;
+
+  void
+  update(uint32_t nodeId);
+
+  void
+  rebinIfNeeded();
+
+  void
+  rebinAll();
+
+  void
+  insertIntoCell(uint32_t nodeId, int64_t cell);
+
+  void
+  removeFromCell(uint32_t nodeId, int64_t cell);
+
+  static void
+  courseChanged(uint32_t nodeId, Ptr<const MobilityModel> model);
+
+private:
+  double m_cellSize;
+  Time m_rebinInterval;
+
+  std::vector<Entry> m_entries; // indexed by node ID
+  size_t m_nIndexed;
+
+  std::unordered_map<int64_t, std::vector<uint32_t>> m_cells;
+  std::unordered_set<uint32_t> m_moving;
+
+  double m_maxSpeed;
+  Time m_lastRebin;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_MODEL_NDN_SPATIAL_INDEX_HPP
@@ -0,0 +1,729 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-replay-mobility-model.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-ns2-trace-line.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceReplayMobilityModel");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(TraceReplayMobilityModel);
+
+/**
+ * Waypoints within this time (in seconds) from now are considered to be in effect, which
+ * compensates for rounding of waypoint times into simulator time
+ */
+static const double TIME_EPSILON = 1e-9;
+
+/**
+ * Waypoint continues the previous movement if it has the same velocity and its position is
+ * within this distance (in meters) from the extrapolated one
+ */
+static const double CONTINUATION_DISTANCE = 0.01;
+
+namespace {
+
+struct Token
+{
+  const char* begin;
+  const char* end;
+
+  bool
+  operator==(const char* str) const
+  {
+    size_t len = std::strlen(str);
+    return static_cast<size_t>(end - begin) == len && std::equal(begin, end, str);
+  }
+};
+
+} // namespace
+
+static bool
+parseNumber(const Token& token, double& value)
+{
+  // the mapped file is not null-terminated
+  char buffer[64];
+  size_t len = token.end - token.begin;
+  if (len == 0 || len >= sizeof(buffer)) {
+    return false;
+  }
+  std::memcpy(buffer, token.begin, len);
+  buffer[len] = '\0';
+
+  char* parsed = nullptr;
+  value = std::strtod(buffer, &parsed);
+  return parsed == buffer + len;
+}
+
+/**
+ * @brief Map the trace file into memory
+ * @return false if the file is empty (cannot be mapped)
+ * @throw std::runtime_error if the file cannot be opened
+ */
+static bool
+mapTraceFile(const std::string& file, boost::iostreams::mapped_file_source& mapped)
+{
+  std::ifstream is(file.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+  if (!is.is_open()) {
+    throw std::runtime_error("Could not open trace file " + file + " for reading");
+  }
+  if (is.tellg() == 0) {
+    return false;
+  }
+  is.close();
+
+  try {
+    mapped.open(file);
+  }
+  catch (const std::exception& e) {
+    throw std::runtime_error("Could not map trace file " + file + ": " + e.what());
+  }
+  return true;
+}
+
+shared_ptr<WaypointTable>
+WaypointTable::LoadNs2(const std::string& file)
+{
+  auto table = make_shared<WaypointTable>();
+
+  boost::iostreams::mapped_file_source mapped;
+  if (!mapTraceFile(file, mapped)) {
+    table->Finalize();
+    return table;
+  }
+
+  const char* pos = mapped.data();
+  const char* end = pos + mapped.size();
+  uint64_t lineNo = 0;
+  while (pos != end) {
+    const char* lineEnd = std::find(pos, end, '\n');
+    ++lineNo;
+
+    try {
+      Ns2TraceLine line = Ns2TraceLine::Parse(pos, lineEnd);
+      if (line.type == Ns2TraceLine::SETDEST) {
+        table->AddWaypoint(line.node, line.time, line.position, line.velocity);
+      }
+      else if (line.type == Ns2TraceLine::SET && !line.isScheduled) {
+        table->SetInitialCoordinate(line.node, line.coordinate, line.value);
+      }
+      else if (line.type == Ns2TraceLine::SET) {
+        // waypoints need both position and velocity, which is not known before Finalize
+        NS_LOG_WARN("Line " << lineNo << " sets position at a later time, which is not "
+                    "supported, ignoring: " << std::string(pos, lineEnd));
+      }
+    }
+    catch (const std::invalid_argument& e) {
+      NS_LOG_ERROR("Line " << lineNo << " is malformed (" << e.what() << "): "
+                   << std::string(pos, lineEnd));
+    }
+
+    pos = lineEnd == end ? end : lineEnd + 1;
+  }
+
+  table->Finalize();
+  NS_LOG_DEBUG("Loaded " << table->GetNWaypoints() << " waypoints of " << table->GetNTracks()
+               << " tracks from " << file);
+  return table;
+}
+
+namespace {
+
+/**
+ * @brief Minimal streaming scanner of XML elements
+ *
+ * Reports start tags with their attributes, skipping end tags, comments, processing
+ * instructions, and character data.  Entity references in attribute values are not decoded.
+ */
+class XmlScanner
+{
+public:
+  XmlScanner(const char* begin, const char* end)
+    : m_pos(begin)
+    , m_end(end)
+  {
+  }
+
+  /**
+   * @brief Advance to the next start tag
+   * @return false at the end of the document
+   */
+  bool
+  NextElement()
+  {
+    while (true) {
+      m_pos = std::find(m_pos, m_end, '<');
+      if (m_pos == m_end) {
+        return false;
+      }
+
+      if (startsWith("<!--")) {
+        skipPast("-->");
+      }
+      else if (startsWith("<?") || startsWith("<!") || startsWith("</")) {
+        skipPast(">");
+      }
+      else {
+        ++m_pos;
+        m_name.begin = m_pos;
+        while (m_pos != m_end && !isSpace(*m_pos) && *m_pos != '/' && *m_pos != '>') {
+          ++m_pos;
+        }
+        m_name.end = m_pos;
+        return true;
+      }
+    }
+  }
+
+  const Token&
+  GetName() const
+  {
+    return m_name;
+  }
+
+  /**
+   * @brief Read the next attribute of the current start tag
+   * @return false after the last attribute
+   */
+  bool
+  NextAttribute(Token& name, Token& value)
+  {
+    while (m_pos != m_end && isSpace(*m_pos)) {
+      ++m_pos;
+    }
+    if (m_pos == m_end || *m_pos == '/' || *m_pos == '>') {
+      return false;
+    }
+
+    name.begin = m_pos;
+    while (m_pos != m_end && *m_pos != '=' && !isSpace(*m_pos) && *m_pos != '>') {
+      ++m_pos;
+    }
+    name.end = m_pos;
+    while (m_pos != m_end && isSpace(*m_pos)) {
+      ++m_pos;
+    }
+    if (m_pos == m_end || *m_pos != '=') {
+      return false; // malformed
+    }
+    ++m_pos;
+    while (m_pos != m_end && isSpace(*m_pos)) {
+      ++m_pos;
+    }
+    if (m_pos == m_end || (*m_pos != '"' && *m_pos != '\'')) {
+      return false; // malformed
+    }
+
+    char quote = *m_pos++;
+    value.begin = m_pos;
+    m_pos = std::find(m_pos, m_end, quote);
+    value.end = m_pos;
+    if (m_pos != m_end) {
+      ++m_pos;
+    }
+    return true;
+  }
+
+private:
+  static bool
+  isSpace(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  bool
+  startsWith(const char* prefix) const
+  {
+    size_t len = std::strlen(prefix);
+    return static_cast<size_t>(m_end - m_pos) >= len && std::equal(prefix, prefix + len, m_pos);
+  }
+
+  void
+  skipPast(const char* terminator)
+  {
+    size_t len = std::strlen(terminator);
+    m_pos = std::search(m_pos, m_end, terminator, terminator + len);
+    m_pos = m_pos == m_end ? m_end : m_pos + len;
+  }
+
+private:
+  const char* m_pos;
+  const char* m_end;
+  Token m_name;
+};
+
+} // namespace
+
+shared_ptr<WaypointTable>
+WaypointTable::LoadFcd(const std::string& file)
+{
+  auto table = make_shared<WaypointTable>();
+
+  boost::iostreams::mapped_file_source mapped;
+  if (!mapTraceFile(file, mapped)) {
+    table->Finalize();
+    return table;
+  }
+
+  std::unordered_map<std::string, uint32_t> tracks;
+  std::vector<double> timesteps;
+  double time = 0;
+  bool isTimeValid = false;
+
+  XmlScanner scanner(mapped.data(), mapped.data() + mapped.size());
+  Token name;
+  Token value;
+  while (scanner.NextElement()) {
+    if (scanner.GetName() == "timestep") {
+      isTimeValid = false;
+      while (scanner.NextAttribute(name, value)) {
+        if (name == "time") {
+          isTimeValid = parseNumber(value, time);
+        }
+      }
+      if (!isTimeValid) {
+        NS_LOG_ERROR("Timestep without valid time in " << file);
+      }
+      else {
+        timesteps.push_back(time);
+      }
+    }
+    else if (scanner.GetName() == "vehicle" && isTimeValid) {
+      Token id = {nullptr, nullptr};
+      double x = 0, y = 0, z = 0, speed = 0, angle = 0;
+      bool isValid = true;
+      bool hasZ = false;
+      while (scanner.NextAttribute(name, value)) {
+        if (name == "id") {
+          id = value;
+        }
+        else if (name == "x") {
+          isValid = isValid && parseNumber(value, x);
+        }
+        else if (name == "y") {
+          isValid = isValid && parseNumber(value, y);
+        }
+        else if (name == "z") {
+          isValid = isValid && (hasZ = parseNumber(value, z));
+        }
+        else if (name == "speed") {
+          isValid = isValid && parseNumber(value, speed);
+        }
+        else if (name == "angle") {
+          isValid = isValid && parseNumber(value, angle);
+        }
+      }
+      if (!isValid || id.begin == id.end) {
+        NS_LOG_ERROR("Malformed vehicle at time " << time << " in " << file);
+        continue;
+      }
+
+      auto inserted = tracks.emplace(std::string(id.begin, id.end), table->m_trackNames.size());
+      uint32_t track = inserted.first->second;
+      if (inserted.second) {
+        table->m_trackNames.push_back(inserted.first->first);
+      }
+      if (hasZ) {
+        table->SetInitialCoordinate(track, 2, z);
+      }
+
+      double heading = angle * M_PI / 180;
+      table->AddWaypoint(track, time, Vector(x, y, 0),
+                         Vector(speed * std::sin(heading), speed * std::cos(heading), 0));
+    }
+  }
+
+  table->Finalize();
+
+  // vehicle arrives at the first timestep it is not reported in
+  std::sort(timesteps.begin(), timesteps.end());
+  for (uint32_t track = 0; track < table->m_tracks.size(); ++track) {
+    const Track& t = table->m_tracks[track];
+    if (t.begin == t.end) {
+      continue;
+    }
+    auto next = std::upper_bound(timesteps.begin(), timesteps.end(),
+                                 table->m_waypoints[t.end - 1].time);
+    if (next != timesteps.end()) {
+      table->SetArrivalTime(track, *next);
+    }
+  }
+
+  NS_LOG_DEBUG("Loaded " << table->GetNWaypoints() << " waypoints of " << table->GetNTracks()
+               << " vehicles from " << file);
+  return table;
+}
+
+WaypointTable::~WaypointTable()
+{
+  m_courseChangeEvent.Cancel();
+}
+
+bool
+WaypointTable::HasTrack(uint32_t track) const
+{
+  return track < m_tracks.size() &&
+         (m_tracks[track].hasInitial || m_tracks[track].begin != m_tracks[track].end);
+}
+
+std::string
+WaypointTable::GetTrackName(uint32_t track) const
+{
+  if (track < m_trackNames.size()) {
+    return m_trackNames[track];
+  }
+  return std::to_string(track);
+}
+
+double
+WaypointTable::GetDepartureTime(uint32_t track) const
+{
+  const Track& t = m_tracks[track];
+  if (t.begin == t.end) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return m_waypoints[t.begin].time;
+}
+
+double
+WaypointTable::GetArrivalTime(uint32_t track) const
+{
+  return m_tracks[track].arrival;
+}
+
+void
+WaypointTable::SetArrivalTime(uint32_t track, double time)
+{
+  if (track >= m_tracks.size()) {
+    m_tracks.resize(track + 1);
+  }
+  m_tracks[track].arrival = time;
+}
+
+void
+WaypointTable::SetInitialPosition(uint32_t track, const Vector& position)
+{
+  if (track >= m_tracks.size()) {
+    m_tracks.resize(track + 1);
+  }
+  m_tracks[track].initial = position;
+  m_tracks[track].hasInitial = true;
+}
+
+void
+WaypointTable::SetInitialCoordinate(uint32_t track, int coordinate, double value)
+{
+  if (track >= m_tracks.size()) {
+    m_tracks.resize(track + 1);
+  }
+  Vector& initial = m_tracks[track].initial;
+  (coordinate == 0 ? initial.x : coordinate == 1 ? initial.y : initial.z) = value;
+  m_tracks[track].hasInitial = true;
+}
+
+void
+WaypointTable::AddWaypoint(uint32_t track, double time, const Vector& position,
+                           const Vector& velocity)
+{
+  if (track >= m_tracks.size()) {
+    m_tracks.resize(track + 1);
+  }
+  Waypoint waypoint = {time, position.x, position.y, velocity.x, velocity.y, 0};
+  m_pending.emplace_back(track, waypoint);
+}
+
+static bool
+continues(const WaypointTable::Waypoint& prev, const WaypointTable::Waypoint& next)
+{
+  if (prev.vx != next.vx || prev.vy != next.vy) {
+    return false;
+  }
+  double dt = next.time - prev.time;
+  double dx = prev.x + prev.vx * dt - next.x;
+  double dy = prev.y + prev.vy * dt - next.y;
+  return dx * dx + dy * dy <= CONTINUATION_DISTANCE * CONTINUATION_DISTANCE;
+}
+
+void
+WaypointTable::Finalize()
+{
+  NS_ASSERT_MSG(m_waypoints.empty(), "WaypointTable is already finalized");
+
+  // SUMO traces are sorted by time, so only the tracks need to be grouped
+  std::stable_sort(m_pending.begin(), m_pending.end(),
+                   [] (const std::pair<uint32_t, Waypoint>& a,
+                       const std::pair<uint32_t, Waypoint>& b) {
+                     return a.first < b.first ||
+                            (a.first == b.first && a.second.time < b.second.time);
+                   });
+  NS_ASSERT_MSG(m_pending.size() < std::numeric_limits<uint32_t>::max(), "Too many waypoints");
+
+  m_waypoints.reserve(m_pending.size());
+  for (const auto& item : m_pending) {
+    m_waypoints.push_back(item.second);
+  }
+
+  uint32_t i = 0;
+  for (uint32_t track = 0; track < m_tracks.size(); ++track) {
+    m_tracks[track].begin = i;
+    while (i < m_pending.size() && m_pending[i].first == track) {
+      ++i;
+    }
+    m_tracks[track].end = i;
+
+    uint32_t nextChange = i;
+    for (uint32_t j = i; j > m_tracks[track].begin; --j) {
+      Waypoint& waypoint = m_waypoints[j - 1];
+      waypoint.nextChange = nextChange;
+      if (j - 1 == m_tracks[track].begin || !continues(m_waypoints[j - 2], waypoint)) {
+        nextChange = j - 1;
+      }
+    }
+  }
+
+  std::vector<std::pair<uint32_t, Waypoint>>().swap(m_pending);
+}
+
+uint32_t
+WaypointTable::Find(uint32_t track, double time, uint32_t cursor) const
+{
+  const Track& t = m_tracks[track];
+  if (t.begin == t.end || time < m_waypoints[t.begin].time) {
+    return t.end;
+  }
+
+  uint32_t lo = t.begin;
+  if (cursor >= t.begin && cursor < t.end && m_waypoints[cursor].time <= time) {
+    if (cursor + 1 == t.end || m_waypoints[cursor + 1].time > time) {
+      return cursor; // still the same waypoint
+    }
+    lo = cursor + 1;
+  }
+
+  auto i = std::upper_bound(m_waypoints.begin() + lo, m_waypoints.begin() + t.end, time,
+                            [] (double time, const Waypoint& waypoint) {
+                              return time < waypoint.time;
+                            });
+  return static_cast<uint32_t>(i - m_waypoints.begin()) - 1;
+}
+
+void
+WaypointTable::Attach(uint32_t track, TraceReplayMobilityModel* model)
+{
+  Track& t = m_tracks[track];
+  t.model = model;
+  ++t.generation; // course changes of an earlier attachment are dropped when due
+  if (t.begin == t.end) {
+    return;
+  }
+
+  uint32_t current = Find(track, Simulator::Now().GetSeconds() + TIME_EPSILON, t.begin);
+  if (current == t.end) {
+    ScheduleCourseChange(track, t.begin);
+  }
+  else if (m_waypoints[current].nextChange != t.end) {
+    ScheduleCourseChange(track, m_waypoints[current].nextChange);
+  }
+}
+
+void
+WaypointTable::Detach(uint32_t track)
+{
+  m_tracks[track].model = nullptr;
+}
+
+void
+WaypointTable::ScheduleCourseChange(uint32_t track, uint32_t waypoint)
+{
+  double time = m_waypoints[waypoint].time;
+  m_courseChanges.emplace(time, track, waypoint, m_tracks[track].generation);
+
+  if (!m_courseChangeEvent.IsRunning() || time < m_courseChangeEventTime) {
+    m_courseChangeEvent.Cancel();
+    m_courseChangeEventTime = time;
+    Time delay = std::max(Seconds(time) - Simulator::Now(), Time(0));
+    m_courseChangeEvent = Simulator::Schedule(delay, &WaypointTable::NotifyCourseChanges, this);
+  }
+}
+
+void
+WaypointTable::NotifyCourseChanges()
+{
+  double now = Simulator::Now().GetSeconds() + TIME_EPSILON;
+  while (!m_courseChanges.empty() && std::get<0>(m_courseChanges.top()) <= now) {
+    uint32_t track = std::get<1>(m_courseChanges.top());
+    uint32_t waypoint = std::get<2>(m_courseChanges.top());
+    uint32_t generation = std::get<3>(m_courseChanges.top());
+    m_courseChanges.pop();
+
+    const Track& t = m_tracks[track];
+    if (!IsCurrent(track, generation)) {
+      continue; // model is gone or the track was attached again
+    }
+
+    // trace sinks expect to run in the context of the node
+    Ptr<TraceReplayMobilityModel> model = t.model;
+    Ptr<Node> node = model->GetObject<Node>();
+    uint32_t context = node != nullptr ? node->GetId() : Simulator::GetContext();
+    Simulator::ScheduleWithContext(context, Seconds(0),
+                                   &TraceReplayMobilityModel::NotifyTrackCourseChange, model,
+                                   generation);
+
+    uint32_t next = m_waypoints[waypoint].nextChange;
+    if (next != t.end) {
+      m_courseChanges.emplace(m_waypoints[next].time, track, next, generation);
+    }
+  }
+
+  if (!m_courseChanges.empty()) {
+    m_courseChangeEventTime = std::get<0>(m_courseChanges.top());
+    Time delay = std::max(Seconds(m_courseChangeEventTime) - Simulator::Now(), Time(0));
+    m_courseChangeEvent = Simulator::Schedule(delay, &WaypointTable::NotifyCourseChanges, this);
+  }
+}
+
+TypeId
+TraceReplayMobilityModel::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::TraceReplayMobilityModel")
+      .SetGroupName("Ndn")
+      .SetParent<MobilityModel>()
+      .AddConstructor<TraceReplayMobilityModel>();
+  return tid;
+}
+
+TraceReplayMobilityModel::TraceReplayMobilityModel()
+  : m_track(0)
+  , m_cursor(0)
+{
+}
+
+TraceReplayMobilityModel::~TraceReplayMobilityModel()
+{
+  if (m_table != nullptr) {
+    m_table->Detach(m_track);
+  }
+}
+
+void
+TraceReplayMobilityModel::SetTrack(shared_ptr<WaypointTable> table, uint32_t track)
+{
+  NS_ASSERT_MSG(table != nullptr && track < table->GetNTracks(),
+                "Track " << track << " is not in the waypoint table");
+
+  if (m_table != nullptr) {
+    m_table->Detach(m_track);
+  }
+
+  m_table = std::move(table);
+  m_track = track;
+  m_cursor = m_table->m_tracks[track].begin;
+  m_initial = m_table->m_tracks[track].initial;
+  m_table->Attach(track, this);
+
+  NotifyCourseChange();
+}
+
+void
+TraceReplayMobilityModel::ClearTrack()
+{
+  if (m_table == nullptr) {
+    return;
+  }
+
+  m_initial = DoGetPosition();
+  m_table->Detach(m_track);
+  m_table = nullptr;
+  NotifyCourseChange();
+}
+
+void
+TraceReplayMobilityModel::NotifyTrackCourseChange(uint32_t generation)
+{
+  if (m_table != nullptr && m_table->IsCurrent(m_track, generation)) {
+    NotifyCourseChange();
+  }
+}
+
+const WaypointTable::Waypoint*
+TraceReplayMobilityModel::GetWaypoint() const
+{
+  if (m_table == nullptr) {
+    return nullptr;
+  }
+
+  uint32_t i = m_table->Find(m_track, Simulator::Now().GetSeconds() + TIME_EPSILON, m_cursor);
+  if (i == m_table->m_tracks[m_track].end) {
+    return nullptr;
+  }
+  m_cursor = i;
+  return &m_table->m_waypoints[i];
+}
+
+Vector
+TraceReplayMobilityModel::DoGetPosition() const
+{
+  const WaypointTable::Waypoint* waypoint = GetWaypoint();
+  if (waypoint == nullptr) {
+    return m_initial;
+  }
+
+  double dt = Simulator::Now().GetSeconds() - waypoint->time;
+  return Vector(waypoint->x + waypoint->vx * dt, waypoint->y + waypoint->vy * dt, m_initial.z);
+}
+
+void
+TraceReplayMobilityModel::DoSetPosition(const Vector& position)
+{
+  // movements come from the trace; only the position before the first waypoint
+  // (and the height) can be changed
+  m_initial = position;
+  NotifyCourseChange();
+}
+
+Vector
+TraceReplayMobilityModel::DoGetVelocity() const
+{
+  const WaypointTable::Waypoint* waypoint = GetWaypoint();
+  if (waypoint == nullptr) {
+    return Vector(0, 0, 0);
+  }
+  return Vector(waypoint->vx, waypoint->vy, 0);
+}
+
+} // namespace ndn
+} // namespace ns3
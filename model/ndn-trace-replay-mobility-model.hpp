@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_MODEL_NDN_TRACE_REPLAY_MOBILITY_MODEL_HPP
+#define NDNSIM_MODEL_NDN_TRACE_REPLAY_MOBILITY_MODEL_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/event-id.h"
+#include "ns3/vector.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class TraceReplayMobilityModel;
+
+/**
+ * @ingroup ndn
+ * @brief Movements of all nodes of a mobility trace, shared by their TraceReplayMobilityModel
+ *
+ * Waypoints are stored once, in a single array sorted by track (node in the trace) and time,
+ * with an offset index per track.  Each waypoint gives position and velocity of the node at the
+ * waypoint time; between waypoints, the node moves with constant velocity.
+ *
+ * The table also notifies CourseChange of attached models, with a single pending simulator
+ * event for all nodes, which hands each due notification to an event in the context of the
+ * model's node.  Waypoints that merely continue the previous movement (the same velocity, and
+ * position within 1 cm of the extrapolated one) do not trigger CourseChange.
+ */
+class WaypointTable : boost::noncopyable {
+public:
+  struct Waypoint
+  {
+    double time; ///< seconds
+    double x;
+    double y;
+    double vx;
+    double vy;
+    uint32_t nextChange; ///< index of the next waypoint of the track that changes the course
+  };
+
+  /**
+   * @brief Read ns-2 movement trace, as exported from SUMO (see Ns2TraceLine)
+   *
+   * The file is memory-mapped and parsed in place.  Malformed lines are logged and skipped, as
+   * are `set` lines scheduled at a later time.
+   *
+   * @throw std::runtime_error if the file cannot be opened
+   */
+  static shared_ptr<WaypointTable>
+  LoadNs2(const std::string& file);
+
+  /**
+   * @brief Read SUMO floating car data (`sumo --fcd-output`)
+   *
+   * The file is memory-mapped and scanned in a single pass, reacting to `timestep` and
+   * `vehicle` elements as they appear, without building a document tree.  Each vehicle id
+   * becomes a track, numbered in order of the first appearance.  Velocity is derived from the
+   * `speed` and `angle` (navigational, degrees clockwise from north) attributes.  A vehicle
+   * departs at its first timestep and arrives at the first timestep in which it is no longer
+   * present.
+   *
+   * @throw std::runtime_error if the file cannot be opened
+   */
+  static shared_ptr<WaypointTable>
+  LoadFcd(const std::string& file);
+
+  ~WaypointTable();
+
+  /**
+   * @brief Get number of tracks (one past the largest node id in the trace)
+   */
+  uint32_t
+  GetNTracks() const
+  {
+    return static_cast<uint32_t>(m_tracks.size());
+  }
+
+  /**
+   * @brief Check whether the trace has any position information for the track
+   */
+  bool
+  HasTrack(uint32_t track) const;
+
+  /**
+   * @brief Get total number of waypoints
+   */
+  size_t
+  GetNWaypoints() const
+  {
+    return m_waypoints.size();
+  }
+
+  /**
+   * @brief Get name of the track: vehicle id for SUMO traces, node id for ns-2 traces
+   */
+  std::string
+  GetTrackName(uint32_t track) const;
+
+  /**
+   * @brief Get time of the first waypoint of the track, or infinity if it has none
+   */
+  double
+  GetDepartureTime(uint32_t track) const;
+
+  /**
+   * @brief Get time when the node leaves the simulated area, or infinity if it does not
+   */
+  double
+  GetArrivalTime(uint32_t track) const;
+
+public: // building the table
+  WaypointTable() = default;
+
+  void
+  SetInitialPosition(uint32_t track, const Vector& position);
+
+  /**
+   * @brief Set one coordinate (0: x, 1: y, 2: z) of the initial position
+   */
+  void
+  SetInitialCoordinate(uint32_t track, int coordinate, double value);
+
+  void
+  AddWaypoint(uint32_t track, double time, const Vector& position, const Vector& velocity);
+
+  void
+  SetArrivalTime(uint32_t track, double time);
+
+  /**
+   * @brief Sort waypoints and build the index; must be called after all waypoints are added
+   */
+  void
+  Finalize();
+
+private:
+  friend class TraceReplayMobilityModel;
+
+  struct Track
+  {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    Vector initial;
+    bool hasInitial = false;
+    double arrival = std::numeric_limits<double>::infinity();
+    TraceReplayMobilityModel* model = nullptr;
+    uint32_t generation = 0; ///< incremented by Attach, see IsCurrent
+  };
+
+  /**
+   * @brief Get waypoint of @p track in effect at @p time, starting search from @p cursor
+   * @return index of the waypoint, or Track::end if @p time is before the first waypoint
+   */
+  uint32_t
+  Find(uint32_t track, double time, uint32_t cursor) const;
+
+  void
+  Attach(uint32_t track, TraceReplayMobilityModel* model);
+
+  void
+  Detach(uint32_t track);
+
+  void
+  ScheduleCourseChange(uint32_t track, uint32_t waypoint);
+
+  /**
+   * @brief Whether course changes scheduled for @p generation of @p track are still valid
+   */
+  bool
+  IsCurrent(uint32_t track, uint32_t generation) const
+  {
+    return m_tracks[track].model != nullptr && m_tracks[track].generation == generation;
+  }
+
+  void
+  NotifyCourseChanges();
+
+private:
+  std::vector<Waypoint> m_waypoints;
+  std::vector<Track> m_tracks;
+  std::vector<std::string> m_trackNames; ///< empty for ns-2 traces
+  std::vector<std::pair<uint32_t, Waypoint>> m_pending; ///< waypoints added before Finalize
+
+  /// time, track, waypoint, generation
+  typedef std::tuple<double, uint32_t, uint32_t, uint32_t> CourseChange;
+  std::priority_queue<CourseChange, std::vector<CourseChange>, std::greater<CourseChange>>
+    m_courseChanges;
+  EventId m_courseChangeEvent;
+  double m_courseChangeEventTime = 0;
+};
+
+/**
+ * @ingroup ndn
+ * @brief Mobility model replaying one track of a shared WaypointTable
+ *
+ * Position is computed on demand from the waypoint in effect at the current time, so the model
+ * keeps only a constant amount of state besides the shared table, and no per-node simulator
+ * events are needed.  CourseChange is fired by the table only when the movement changes.
+ *
+ * Before the first waypoint, the node stays at the initial position given in the trace (or set
+ * with SetPosition).  After the last waypoint, the node keeps the last velocity.
+ */
+class TraceReplayMobilityModel : public MobilityModel {
+public:
+  static TypeId
+  GetTypeId();
+
+  TraceReplayMobilityModel();
+
+  virtual
+  ~TraceReplayMobilityModel();
+
+  /**
+   * @brief Replay @p track of @p table
+   */
+  void
+  SetTrack(shared_ptr<WaypointTable> table, uint32_t track);
+
+  /**
+   * @brief Stop replaying the track; the node stays at its current position
+   */
+  void
+  ClearTrack();
+
+private:
+  virtual Vector
+  DoGetPosition() const;
+
+  virtual void
+  DoSetPosition(const Vector& position);
+
+  virtual Vector
+  DoGetVelocity() const;
+
+  /**
+   * @brief Get the waypoint in effect now, or nullptr before the first waypoint
+   */
+  const WaypointTable::Waypoint*
+  GetWaypoint() const;
+
+  /**
+   * @brief Fire CourseChange scheduled by the table, unless the track was detached or
+   *        re-attached since
+   */
+  void
+  NotifyTrackCourseChange(uint32_t generation);
+
+private:
+  friend class WaypointTable;
+
+  shared_ptr<WaypointTable> m_table;
+  uint32_t m_track;
+  mutable uint32_t m_cursor;
+  Vector m_initial;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_MODEL_NDN_TRACE_REPLAY_MOBILITY_MODEL_HPP
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_TESTS_OTHER_NDN_BENCHMARK_COMMON_HPP
+#define NDNSIM_TESTS_OTHER_NDN_BENCHMARK_COMMON_HPP
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+
+namespace ns3 {
+namespace benchmark {
+
+/**
+ * @brief Wall-clock time in seconds, for measuring intervals of benchmark phases
+ */
+inline double
+getRealTime()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Create a chain of @p nNodes nodes connected by point-to-point links
+ *
+ * Device 0 of every node except the first one faces the previous node in the chain.
+ */
+inline NodeContainer
+createChain(uint32_t nNodes)
+{
+  NodeContainer nodes;
+  nodes.Create(nNodes);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    p2p.Install(nodes.Get(i - 1), nodes.Get(i));
+  }
+  return nodes;
+}
+
+/**
+ * @brief Connect @p hub to each of @p nLeaves new nodes by point-to-point links
+ * @return the leaf nodes
+ */
+inline NodeContainer
+createStar(Ptr<Node> hub, uint32_t nLeaves)
+{
+  NodeContainer leaves;
+  leaves.Create(nLeaves);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < nLeaves; ++i) {
+    p2p.Install(hub, leaves.Get(i));
+  }
+  return leaves;
+}
+
+} // namespace benchmark
+} // namespace ns3
+
+#endif // NDNSIM_TESTS_OTHER_NDN_BENCHMARK_COMMON_HPP
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-face-lookup-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Measures helpers that look up faces by NetDevice on a high-degree router: a star with one
+ * hub connected to D leaf nodes (D faces on the hub):
+ *
+ *     ./waf --run "ndn-face-lookup-benchmark --degree=1024"
+ */
+
+int
+run(int argc, char* argv[])
+{
+  uint32_t degree = 512;
+
+  CommandLine cmd;
+  cmd.AddValue("degree", "Number of faces on the hub router", degree);
+  cmd.Parse(argc, argv);
+
+  Ptr<Node> hub = CreateObject<Node>();
+  NodeContainer leaves = benchmark::createStar(hub, degree);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.enableMinimalStack();
+  ndnHelper.Install(hub);
+  ndnHelper.Install(leaves);
+
+  // every device on the hub already has a face
+  double beginTime = benchmark::getRealTime();
+  ndnHelper.Update(hub);
+  double updateTime = benchmark::getRealTime() - beginTime;
+
+  beginTime = benchmark::getRealTime();
+  for (uint32_t i = 0; i < degree; ++i) {
+    ndn::FibHelper::AddRoute(hub, Name("/leaf").appendNumber(i), leaves.Get(i), 1);
+  }
+  double addRouteTime = benchmark::getRealTime() - beginTime;
+
+  beginTime = benchmark::getRealTime();
+  for (uint32_t i = 0; i < degree; ++i) {
+    ndn::LinkControlHelper::FailLink(hub, leaves.Get(i));
+  }
+  double failLinkTime = benchmark::getRealTime() - beginTime;
+
+  beginTime = benchmark::getRealTime();
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.Install(hub);
+  double routingInstallTime = benchmark::getRealTime() - beginTime;
+
+  std::cout << "Degree"
+            << "\t"
+            << "StackHelper::Update (s)"
+            << "\t"
+            << "FibHelper::AddRoute (s)"
+            << "\t"
+            << "LinkControlHelper::FailLink (s)"
+            << "\t"
+            << "GlobalRoutingHelper::Install (s)"
+            << "\n";
+
+  std::cout << degree << "\t"
+            << updateTime << "\t"
+            << addRouteTime << "\t"
+            << failLinkTime << "\t"
+            << routingInstallTime << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::run(argc, argv);
+}
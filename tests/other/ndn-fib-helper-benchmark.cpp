@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-fib-helper-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Measures time to install P routes on each of N nodes (chain topology) through NFD's FIB
+ * manager (FibHelper::AddRoute, signed command Interests) and directly
+ * (FibHelper::AddRoutesDirect):
+ *
+ *     ./waf --run "ndn-fib-helper-benchmark --nodes=100 --prefixes=1000 --direct=0"
+ *     ./waf --run "ndn-fib-helper-benchmark --nodes=100 --prefixes=1000 --direct=1"
+ */
+
+int
+run(int argc, char* argv[])
+{
+  uint32_t nNodes = 100;
+  uint32_t nPrefixes = 1000;
+  bool isDirect = false;
+
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes", nNodes);
+  cmd.AddValue("prefixes", "Number of routes per node", nPrefixes);
+  cmd.AddValue("direct", "Install routes directly to FIB", isDirect);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes = benchmark::createChain(nNodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(nodes);
+
+  std::vector<Name> prefixes;
+  for (uint32_t i = 0; i < nPrefixes; ++i) {
+    prefixes.push_back(Name("/prefix").appendNumber(i));
+  }
+
+  double beginTime = benchmark::getRealTime();
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    Ptr<Node> node = nodes.Get(i);
+    shared_ptr<Face> face =
+      node->GetObject<ndn::L3Protocol>()->getFaceByNetDevice(node->GetDevice(0));
+
+    if (isDirect) {
+      std::vector<ndn::FibHelper::Route> routes;
+      for (const auto& prefix : prefixes) {
+        routes.push_back({prefix, face, 1});
+      }
+      ndn::FibHelper::AddRoutesDirect(node, routes);
+    }
+    else {
+      for (const auto& prefix : prefixes) {
+        ndn::FibHelper::AddRoute(node, prefix, face, 1);
+      }
+    }
+  }
+  // FIB manager processes commands asynchronously
+  Simulator::Run();
+  double routeTime = benchmark::getRealTime() - beginTime;
+
+  size_t nFibEntries = 0;
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    nFibEntries += nodes.Get(i)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib().size();
+  }
+
+  std::cout << "Mode"
+            << "\t"
+            << "Nodes"
+            << "\t"
+            << "Routes"
+            << "\t"
+            << "FIB entries"
+            << "\t"
+            << "Time (s)"
+            << "\t"
+            << "Routes per second"
+            << "\n";
+
+  double nRoutes = static_cast<double>(nNodes - 1) * nPrefixes;
+  std::cout << (isDirect ? "direct" : "command") << "\t"
+            << nNodes << "\t"
+            << nRoutes << "\t"
+            << nFibEntries << "\t"
+            << routeTime << "\t"
+            << nRoutes / routeTime << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::run(argc, argv);
+}
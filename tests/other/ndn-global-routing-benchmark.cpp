@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-global-routing-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Measures time of GlobalRoutingHelper::CalculateRoutes, either on a Rocketfuel map (.cch file)
+ * or on a random connected topology of N nodes, with every node originating one prefix:
+ *
+ *     ./waf --run "ndn-global-routing-benchmark --topology=/path/to/1239.r0.cch --threads=1"
+ *     ./waf --run "ndn-global-routing-benchmark --nodes=1000 --threads=0"
+ */
+
+static NodeContainer
+readRocketfuel(const std::string& file)
+{
+  RocketfuelParams params;
+  params.averageRtt = 2.0;
+  params.clientNodeDegrees = 2;
+  params.minb2bBandwidth = "40Mbps";
+  params.minb2bDelay = "5ms";
+  params.maxb2bBandwidth = "100Mbps";
+  params.maxb2bDelay = "10ms";
+  params.minb2gBandwidth = "10Mbps";
+  params.minb2gDelay = "5ms";
+  params.maxb2gBandwidth = "20Mbps";
+  params.maxb2gDelay = "10ms";
+  params.ming2cBandwidth = "1Mbps";
+  params.ming2cDelay = "70ms";
+  params.maxg2cBandwidth = "3Mbps";
+  params.maxg2cDelay = "10ms";
+
+  RocketfuelMapReader reader(file);
+  return reader.Read(params, true, true);
+}
+
+static NodeContainer
+createRandomTopology(uint32_t nNodes, uint32_t degree)
+{
+  NodeContainer nodes;
+  nodes.Create(nNodes);
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+  PointToPointHelper p2p;
+
+  // random tree to keep the topology connected, plus extra random links
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    p2p.Install(nodes.Get(i), nodes.Get(rand->GetInteger(0, i - 1)));
+  }
+  for (uint32_t i = 0; i < nNodes * (degree - 2) / 2; ++i) {
+    uint32_t a = rand->GetInteger(0, nNodes - 1);
+    uint32_t b = rand->GetInteger(0, nNodes - 1);
+    if (a != b) {
+      p2p.Install(nodes.Get(a), nodes.Get(b));
+    }
+  }
+  return nodes;
+}
+
+int
+run(int argc, char* argv[])
+{
+  std::string topology;
+  uint32_t nNodes = 1000;
+  uint32_t degree = 4;
+  uint32_t nThreads = 0;
+
+  CommandLine cmd;
+  cmd.AddValue("topology", "Rocketfuel map (.cch) file, random topology if empty", topology);
+  cmd.AddValue("nodes", "Number of nodes in random topology", nNodes);
+  cmd.AddValue("degree", "Average node degree in random topology", degree);
+  cmd.AddValue("threads", "Number of route calculation threads (0 for all cores)", nThreads);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes = topology.empty() ? createRandomTopology(nNodes, std::max(degree, 2u))
+                                         : readRocketfuel(topology);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.enableMinimalStack();
+  ndnHelper.Install(nodes);
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.Install(nodes);
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    routingHelper.AddOrigin("/node/" + std::to_string(nodes.Get(i)->GetId()), nodes.Get(i));
+  }
+
+  double beginTime = benchmark::getRealTime();
+  ndn::GlobalRoutingHelper::CalculateRoutes(nThreads);
+  double routeTime = benchmark::getRealTime() - beginTime;
+
+  std::cout << "Topology"
+            << "\t"
+            << "Nodes"
+            << "\t"
+            << "Threads"
+            << "\t"
+            << "CalculateRoutes (s)"
+            << "\n";
+
+  std::cout << (topology.empty() ? "random" : topology) << "\t"
+            << nodes.GetN() << "\t"
+            << nThreads << "\t"
+            << routeTime << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::run(argc, argv);
+}
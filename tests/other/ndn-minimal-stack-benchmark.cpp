@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-minimal-stack-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Measures memory footprint and installation time of the NDN stack on a chain of N nodes,
+ * with and without NFD management and RIB service:
+ *
+ *     ./waf --run "ndn-minimal-stack-benchmark --nodes=1000"
+ *     ./waf --run "ndn-minimal-stack-benchmark --nodes=1000 --minimal=1"
+ */
+
+int
+run(int argc, char* argv[])
+{
+  uint32_t nNodes = 1000;
+  bool isMinimal = false;
+
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes", nNodes);
+  cmd.AddValue("minimal", "Install minimal stack (no management, no RIB)", isMinimal);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes = benchmark::createChain(nNodes);
+
+  ndn::StackHelper ndnHelper;
+  if (isMinimal) {
+    ndnHelper.enableMinimalStack();
+  }
+
+  double initialMemory = MemUsage::Get() / 1024.0 / 1024.0;
+  double beginTime = benchmark::getRealTime();
+
+  ndnHelper.Install(nodes);
+
+  double installTime = benchmark::getRealTime() - beginTime;
+  double installMemory = MemUsage::Get() / 1024.0 / 1024.0 - initialMemory;
+
+  beginTime = benchmark::getRealTime();
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    ndn::FibHelper::AddRoute(nodes.Get(i), "/prefix", nodes.Get(i - 1), 1);
+  }
+  double routeTime = benchmark::getRealTime() - beginTime;
+
+  std::cout << "Mode"
+            << "\t"
+            << "Nodes"
+            << "\t"
+            << "InstallTime (s)"
+            << "\t"
+            << "Memory (MiB)"
+            << "\t"
+            << "Memory per node (KiB)"
+            << "\t"
+            << "AddRouteTime (s)"
+            << "\n";
+
+  std::cout << (isMinimal ? "minimal" : "full") << "\t"
+            << nNodes << "\t"
+            << installTime << "\t"
+            << installMemory << "\t"
+            << 1024 * installMemory / nNodes << "\t"
+            << routeTime << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::run(argc, argv);
+}
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+// ndn-rtt-estimator-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-rtt-mean-deviation.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace ns3 {
+
+/**
+ * Benchmark of RttMeanDeviation with many outstanding Interests acknowledged out of order
+ *
+ * Keeps the given number of sequence numbers outstanding: every acknowledgement of a randomly
+ * chosen outstanding sequence number is followed by a send of the next one, as a large
+ * ConsumerWindow does with Data arriving out of order.  A fraction of sequence numbers is sent
+ * twice to exercise Karn's rule.  "legacy" mode scans the history list as RttMeanDeviation did
+ * before, "window" mode uses the current implementation:
+ *
+ *     ./waf --run "ndn-rtt-estimator-benchmark --mode=legacy --outstanding=10000"
+ *     ./waf --run "ndn-rtt-estimator-benchmark --mode=window --outstanding=10000"
+ */
+
+class LegacyRttMeanDeviation : public ndn::RttMeanDeviation
+{
+public:
+  void
+  SentSeq(SequenceNumber32 seq, uint32_t size) override
+  {
+    ndn::RttHistory_t::iterator i;
+    for (i = m_history.begin(); i != m_history.end(); ++i) {
+      if (seq == i->seq) {
+        i->retx = true;
+        break;
+      }
+    }
+    if (i == m_history.end())
+      m_history.push_back(ndn::RttHistory(seq, size, Simulator::Now()));
+  }
+
+  Time
+  AckSeq(SequenceNumber32 ackSeq) override
+  {
+    Time m = Seconds(0.0);
+    for (ndn::RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i) {
+      if (ackSeq == i->seq) {
+        if (!i->retx) {
+          m = Simulator::Now() - i->time;
+          Measurement(m);
+          ResetMultiplier();
+        }
+        m_history.erase(i);
+        break;
+      }
+    }
+    return m;
+  }
+};
+
+int
+run(int argc, char* argv[])
+{
+  std::string mode = "window";
+  uint32_t nOutstanding = 10000;
+  uint32_t nAcks = 1000000;
+  double retxRatio = 0.01;
+
+  CommandLine cmd;
+  cmd.AddValue("mode", "legacy or window", mode);
+  cmd.AddValue("outstanding", "Number of outstanding Interests", nOutstanding);
+  cmd.AddValue("acks", "Number of acknowledgements", nAcks);
+  cmd.AddValue("retx", "Fraction of sequence numbers sent twice", retxRatio);
+  cmd.Parse(argc, argv);
+
+  Ptr<ndn::RttMeanDeviation> rtt;
+  if (mode == "legacy") {
+    rtt = CreateObject<LegacyRttMeanDeviation>();
+  }
+  else {
+    rtt = CreateObject<ndn::RttMeanDeviation>();
+  }
+
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> coin;
+
+  std::vector<uint32_t> outstanding;
+  uint32_t next = 0;
+  for (; next < nOutstanding; ++next) {
+    rtt->SentSeq(SequenceNumber32(next), 1);
+    outstanding.push_back(next);
+  }
+
+  double beginTime = benchmark::getRealTime();
+  for (uint32_t i = 0; i < nAcks; ++i) {
+    std::uniform_int_distribution<size_t> pick(0, outstanding.size() - 1);
+    size_t index = pick(random);
+    uint32_t seq = outstanding[index];
+
+    if (coin(random) < retxRatio) {
+      rtt->SentSeq(SequenceNumber32(seq), 1); // retransmission, not sampled
+    }
+    rtt->AckSeq(SequenceNumber32(seq));
+
+    outstanding[index] = next;
+    rtt->SentSeq(SequenceNumber32(next++), 1);
+  }
+  double realTime = benchmark::getRealTime() - beginTime;
+
+  std::cout << "Mode"
+            << "\t"
+            << "Outstanding"
+            << "\t"
+            << "Acks"
+            << "\t"
+            << "RealTime (s)"
+            << "\t"
+            << "PerAck (us)"
+            << "\n";
+
+  std::cout << mode << "\t"
+            << nOutstanding << "\t"
+            << nAcks << "\t"
+            << realTime << "\t"
+            << realTime / nAcks * 1e6 << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::run(argc, argv);
+}
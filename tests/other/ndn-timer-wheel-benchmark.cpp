@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-timer-wheel-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-timer-wheel.hpp"
+#include "ns3/ndnSIM/NFD/daemon/common/global.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+#include <sys/resource.h>
+
+#include <list>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * Benchmark of deferred transmissions in DirectedGeocastStrategy
+ *
+ * Each of N nodes overhears Interests at the given rate and defers their retransmission by
+ * a random 20-100 ms, about half of them are cancelled by overheard duplicates.  "legacy" mode
+ * does what the strategy did before: copy the Interest into a lambda, schedule it in the global
+ * scheduler, and keep a ScopedEventId; "wheel" mode shares the Interest and uses a per-node
+ * TimerWheel.  Each mode should run in a separate process to get a meaningful peak RSS:
+ *
+ *     ./waf --run "ndn-timer-wheel-benchmark --mode=legacy"
+ *     ./waf --run "ndn-timer-wheel-benchmark --mode=wheel"
+ */
+
+struct Deferral
+{
+  ::nfd::scheduler::ScopedEventId event;
+  ndn::TimerWheel::TimerId timer;
+};
+
+class BenchmarkNode
+{
+public:
+  BenchmarkNode(bool useWheel, Ptr<UniformRandomVariable> random)
+    : m_useWheel(useWheel)
+    , m_random(random)
+  {
+  }
+
+  void
+  onInterest(const shared_ptr<Interest>& interest)
+  {
+    uint64_t id = m_nextId++;
+    Time delay = Seconds(m_random->GetValue(0.02, 0.1));
+
+    if (m_useWheel) {
+      m_deferrals[id].timer = m_wheel.schedule(delay, [this, id, interest] {
+          m_nSent += interest->getName().size() > 0;
+          m_deferrals.erase(id);
+        });
+    }
+    else {
+      Interest copy(*interest);
+      auto nfdDelay = ::ndn::time::nanoseconds(delay.GetNanoSeconds());
+      m_deferrals[id].event = ::nfd::getScheduler().schedule(nfdDelay, [this, id, copy] {
+          m_nSent += copy.getName().size() > 0;
+          m_deferrals.erase(id);
+        });
+    }
+    m_peakPending = std::max(m_peakPending, m_deferrals.size());
+
+    if (m_random->GetValue() < 0.5) {
+      // duplicate overheard before the deferred transmission
+      Simulator::Schedule(Seconds(m_random->GetValue(0, delay.GetSeconds())),
+                          &BenchmarkNode::onDuplicate, this, id);
+    }
+  }
+
+  void
+  onDuplicate(uint64_t id)
+  {
+    auto item = m_deferrals.find(id);
+    if (item == m_deferrals.end()) {
+      return;
+    }
+    if (m_useWheel) {
+      m_wheel.cancel(item->second.timer);
+    }
+    else {
+      item->second.event.cancel();
+    }
+    m_deferrals.erase(item);
+    ++m_nCanceled;
+  }
+
+public:
+  uint64_t m_nSent = 0;
+  uint64_t m_nCanceled = 0;
+  size_t m_peakPending = 0;
+
+private:
+  bool m_useWheel;
+  Ptr<UniformRandomVariable> m_random;
+  ndn::TimerWheel m_wheel;
+  std::map<uint64_t, Deferral> m_deferrals;
+  uint64_t m_nextId = 0;
+};
+
+static void
+generateInterests(std::list<BenchmarkNode>& nodes, shared_ptr<Interest> interest, Time interval)
+{
+  for (auto& node : nodes) {
+    node.onInterest(interest);
+  }
+  Simulator::Schedule(interval, &generateInterests, std::ref(nodes), interest, interval);
+}
+
+int
+run(int argc, char* argv[])
+{
+  std::string mode = "wheel";
+  uint32_t nNodes = 100;
+  double rate = 1000;
+  Time simTime = Seconds(10);
+
+  CommandLine cmd;
+  cmd.AddValue("mode", "legacy or wheel", mode);
+  cmd.AddValue("nodes", "Number of nodes", nNodes);
+  cmd.AddValue("rate", "Overheard Interests per second per node", rate);
+  cmd.AddValue("sim-time", "Simulation time", simTime);
+  cmd.Parse(argc, argv);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+
+  std::list<BenchmarkNode> nodes;
+  for (uint32_t i = 0; i < nNodes; ++i) {
+    nodes.emplace_back(mode == "wheel", random);
+  }
+
+  auto interest = make_shared<Interest>("/v2safety/8thStreet/0,0,0/300,0,0/100");
+  interest->setNonce(1);
+  interest->setApplicationParameters(make_shared<::ndn::Buffer>(200));
+
+  Simulator::Schedule(Seconds(0), &generateInterests, std::ref(nodes), interest, Seconds(1.0 / rate));
+  Simulator::Stop(simTime);
+
+  double beginTime = benchmark::getRealTime();
+  Simulator::Run();
+  double realTime = benchmark::getRealTime() - beginTime;
+
+  uint64_t nSent = 0;
+  uint64_t nCanceled = 0;
+  size_t peakPending = 0;
+  for (const auto& node : nodes) {
+    nSent += node.m_nSent;
+    nCanceled += node.m_nCanceled;
+    peakPending = std::max(peakPending, node.m_peakPending);
+  }
+
+  ::rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  std::cout << "Mode"
+            << "\t"
+            << "Sent"
+            << "\t"
+            << "Canceled"
+            << "\t"
+            << "PeakPendingPerNode"
+            << "\t"
+            << "SchedulerEvents"
+            << "\t"
+            << "RealTime (s)"
+            << "\t"
+            << "PeakRSS (MiB)"
+            << "\n";
+
+  std::cout << mode << "\t"
+            << nSent << "\t"
+            << nCanceled << "\t"
+            << peakPending << "\t"
+            << Simulator::GetEventCount() << "\t"
+            << realTime << "\t"
+            << usage.ru_maxrss / 1024.0 << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::run(argc, argv);
+}
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "apps/ndn-producer.hpp"
+
+#include <map>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ProducerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ProducerFixture()
+  {
+    createTopology({
+        {"1"},
+        {"2"},
+      });
+
+    // same Interests and Data parameters on both nodes, only the Data construction differs
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.95s"},
+        {"1", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1200"}, {"Freshness", "2s"},
+             {"Signature", "100"}, {"KeyLocator", "/key"}, {"UseDataTemplate", "true"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.95s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1200"}, {"Freshness", "2s"},
+             {"Signature", "100"}, {"KeyLocator", "/key"}, {"UseDataTemplate", "false"}},
+            "0s", "100s"},
+      });
+
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::Producer/"
+                                  "TransmittedDatas",
+                                  MakeCallback(&ProducerFixture::onData, this));
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face> face)
+  {
+    datas[app->GetNode()->GetId()].push_back(data->wireEncode());
+  }
+
+public:
+  std::map<uint32_t, std::vector<Block>> datas;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnProducer, ProducerFixture)
+
+BOOST_AUTO_TEST_CASE(DataTemplate)
+{
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  const auto& templated = datas[getNode("1")->GetId()];
+  const auto& constructed = datas[getNode("2")->GetId()];
+  BOOST_REQUIRE_EQUAL(templated.size(), 10);
+  BOOST_REQUIRE_EQUAL(constructed.size(), 10);
+
+  for (size_t i = 0; i < templated.size(); ++i) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(templated[i].begin(), templated[i].end(),
+                                  constructed[i].begin(), constructed[i].end());
+
+    Data data(templated[i]);
+    BOOST_CHECK_EQUAL(data.getName(), Name("/prefix").appendSequenceNumber(i));
+    BOOST_CHECK_EQUAL(data.getContent().value_size(), 1200);
+    BOOST_CHECK_EQUAL(data.getFreshnessPeriod(), ::ndn::time::milliseconds(2000));
+    BOOST_CHECK_EQUAL(data.getSignature().getKeyLocator().getName(), Name("/key"));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/custom-helper.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/mobility-model.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_NS2_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "custom-helper.tcl";
+
+class CustomHelperFixture : public CleanupFixture
+{
+public:
+  CustomHelperFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    std::ofstream os(TEST_NS2_TRACE.string().c_str());
+    os << "$node_(0) set X_ 1\n"
+       << "$node_(0) set Y_ 2\n"
+       << "$ns_ at 1 \"$node_(0) setdest 10 0 10 0\"\n"
+       << "$ns_ at 3 \"$node_(0) set X_ 100\"\n"
+       << "$ns_ at 2 \"$node_(1) setdest 5 5 1 90\"\n"
+       << "$ns_ at 5 \"$node_(0) setdest 0 0 0 0\"\n"
+       << "# out of order\n"
+       << "$ns_ at 4 \"$node_(0) set Y_ 7\"\n"
+       << "$node_(5) set X_ 1\n"                         // unknown node
+       << "$ns_ at x \"$node_(1) setdest 1 2 3 4\"\n";   // malformed
+  }
+
+  ~CustomHelperFixture()
+  {
+    boost::filesystem::remove(TEST_NS2_TRACE);
+  }
+
+  void
+  checkPosition(Ptr<Node> node, const Vector& expected)
+  {
+    Vector position = node->GetObject<MobilityModel>()->GetPosition();
+    BOOST_CHECK_SMALL(position.x - expected.x, 1e-6);
+    BOOST_CHECK_SMALL(position.y - expected.y, 1e-6);
+    BOOST_CHECK_SMALL(position.z - expected.z, 1e-6);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperCustomHelper, CustomHelperFixture)
+
+BOOST_AUTO_TEST_CASE(Movements)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  CustomHelper helper(TEST_NS2_TRACE.string());
+  helper.Install(nodes.Begin(), nodes.End());
+  BOOST_REQUIRE(nodes.Get(0)->GetObject<MobilityModel>() != nullptr);
+  BOOST_REQUIRE(nodes.Get(1)->GetObject<MobilityModel>() != nullptr);
+
+  Simulator::Schedule(Seconds(0.5), [&] {
+      checkPosition(nodes.Get(0), Vector(1, 2, 0));
+      checkPosition(nodes.Get(1), Vector(0, 0, 0));
+    });
+  Simulator::Schedule(Seconds(2.5), [&] {
+      checkPosition(nodes.Get(0), Vector(25, 0, 0));
+      checkPosition(nodes.Get(1), Vector(5, 5.5, 0));
+    });
+  // scheduled set lines change one coordinate and keep the velocity
+  Simulator::Schedule(Seconds(3.5), [&] {
+      checkPosition(nodes.Get(0), Vector(105, 0, 0));
+    });
+  Simulator::Schedule(Seconds(4.5), [&] {
+      checkPosition(nodes.Get(0), Vector(115, 7, 0));
+    });
+  Simulator::Schedule(Seconds(5.5), [&] {
+      checkPosition(nodes.Get(0), Vector(0, 0, 0));
+    });
+
+  Simulator::Stop(Seconds(6));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
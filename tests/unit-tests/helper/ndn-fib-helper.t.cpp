@@ -18,6 +18,9 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -97,6 +100,39 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRouteDirect(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric);
+BOOST_AUTO_TEST_CASE(Direct)
+{
+  FibHelper::AddRouteDirect(getNode("1"), Name("/prefix"), getFace("1", "2"), 1);
+
+  // entry is available immediately, without running the FIB manager
+  auto& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  const nfd::fib::Entry* entry = fib.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(&entry->getNextHops().front().getFace(), getFace("1", "2").get());
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 1);
+}
+
+// static void
+// AddRoutesDirect(Ptr<Node> node, const std::vector<Route>& routes);
+BOOST_AUTO_TEST_CASE(DirectBatch)
+{
+  FibHelper::AddRoutesDirect(getNode("1"), {{"/other", getFace("1", "2"), 5},
+                                            {"/prefix", getFace("1", "2"), 1}});
+
+  // entries are available immediately, without running the FIB manager
+  auto& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  for (const auto& route : std::vector<std::pair<Name, uint64_t>>{{"/other", 5}, {"/prefix", 1}}) {
+    const nfd::fib::Entry* entry = fib.findExactMatch(route.first);
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+    BOOST_CHECK_EQUAL(&entry->getNextHops().front().getFace(), getFace("1", "2").get());
+    BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), route.second);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
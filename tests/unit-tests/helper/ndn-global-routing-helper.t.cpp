@@ -33,9 +33,15 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/point-to-point-layout-module.h"
 
+#include "helper/boost-graph-ndn-global-routing-helper.hpp"
+
 #include "../tests-common.hpp"
 
 #include <boost/filesystem.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+#include <set>
+#include <tuple>
 
 namespace ns3 {
 namespace ndn {
@@ -54,6 +60,84 @@ public:
   {
     boost::filesystem::remove(TEST_TOPO_TXT);
   }
+
+  /**
+   * @brief Create a grid of nodes with NDN stack and GlobalRouter, each originating a prefix
+   *
+   * All links have the same metric, so there are many equal-cost paths.
+   */
+  void
+  createGrid(uint32_t size, bool isMinimal)
+  {
+    PointToPointHelper p2p;
+    PointToPointGridHelper grid(size, size, p2p);
+
+    StackHelper ndnHelper;
+    if (isMinimal) {
+      ndnHelper.enableMinimalStack();
+    }
+    ndnHelper.InstallAll();
+
+    GlobalRoutingHelper routingHelper;
+    routingHelper.InstallAll();
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+      routingHelper.AddOrigin("/node/" + std::to_string((*node)->GetId()), *node);
+    }
+  }
+
+  typedef std::set<std::tuple<uint32_t, Name, nfd::FaceId, uint64_t>> Routes;
+
+  /**
+   * @brief Get (node, prefix, face, cost) of all next hops through NetDevice faces
+   */
+  Routes
+  getFibRoutes()
+  {
+    Routes routes;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+      auto forwarder = (*node)->GetObject<L3Protocol>()->getForwarder();
+      for (const auto& entry : forwarder->getFib()) {
+        for (const auto& nextHop : entry.getNextHops()) {
+          if (dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport()) != nullptr) {
+            routes.emplace((*node)->GetId(), entry.getPrefix(), nextHop.getFace().getId(),
+                           nextHop.getCost());
+          }
+        }
+      }
+    }
+    return routes;
+  }
+
+  /**
+   * @brief Compute routes with boost::dijkstra_shortest_paths, as CalculateRoutes did before
+   */
+  Routes
+  getBglRoutes()
+  {
+    Routes routes;
+    boost::NdnGlobalRouterGraph graph;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+      Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
+      boost::DistancesMap distances;
+      dijkstra_shortest_paths(graph, source,
+                              distance_map(boost::ref(distances))
+                                .distance_inf(boost::WeightInf)
+                                .distance_zero(boost::WeightZero)
+                                .distance_compare(boost::WeightCompare())
+                                .distance_combine(boost::WeightCombine()));
+
+      for (const auto& dist : distances) {
+        if (dist.first == source || std::get<0>(dist.second) == nullptr) {
+          continue;
+        }
+        for (const auto& prefix : dist.first->GetLocalPrefixes()) {
+          routes.emplace((*node)->GetId(), *prefix, std::get<0>(dist.second)->getId(),
+                         std::get<1>(dist.second));
+        }
+      }
+    }
+    return routes;
+  }
 };
 
 BOOST_FIXTURE_TEST_SUITE(HelperGlobalRoutingHelper, GlobalRoutingHelperFixture)
@@ -190,6 +274,45 @@ BOOST_AUTO_TEST_CASE(CalculateRoutesBasedOnLinkDelay)
   }
 }
 
+BOOST_AUTO_TEST_CASE(EqualCostPaths)
+{
+  createGrid(4, true);
+  Routes expected = getBglRoutes();
+  BOOST_REQUIRE_EQUAL(expected.size(), 16 * 15);
+
+  GlobalRoutingHelper::CalculateRoutes(1);
+
+  // same first face among equal-cost paths as with boost::dijkstra_shortest_paths
+  Routes routes = getFibRoutes();
+  BOOST_CHECK(routes == expected);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadCount)
+{
+  createGrid(5, true);
+
+  GlobalRoutingHelper::CalculateRoutes(1);
+  Routes routes = getFibRoutes();
+  BOOST_CHECK_EQUAL(routes.size(), 25 * 24);
+
+  // next hops that differ from the single-threaded ones would be added to the FIB entries
+  GlobalRoutingHelper::CalculateRoutes(4);
+  BOOST_CHECK(getFibRoutes() == routes);
+}
+
+BOOST_AUTO_TEST_CASE(ManagementStack)
+{
+  createGrid(3, false);
+  Routes expected = getBglRoutes();
+
+  // routes are added through FibManager
+  GlobalRoutingHelper::CalculateRoutes();
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  BOOST_CHECK(getFibRoutes() == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
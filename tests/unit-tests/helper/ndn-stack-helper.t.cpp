@@ -18,6 +18,10 @@
  **/
 
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
 #include "../tests-common.hpp"
 
 #include "ns3/point-to-point-module.h"
@@ -62,6 +66,72 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+BOOST_AUTO_TEST_CASE(InstallContainer)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(nodes);
+
+  // installed before the container Install returns
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    Ptr<L3Protocol> l3 = L3Protocol::getL3Protocol(nodes.Get(i));
+    BOOST_REQUIRE(l3 != nullptr);
+    for (uint32_t j = 0; j < nodes.Get(i)->GetNDevices(); ++j) {
+      BOOST_CHECK(l3->getFaceByNetDevice(nodes.Get(i)->GetDevice(j)) != nullptr);
+    }
+  }
+
+  StrategyChoiceHelper::Install(nodes, "/prefix", "/localhost/nfd/strategy/multicast");
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    auto& strategy = L3Protocol::getL3Protocol(nodes.Get(i))->getForwarder()
+                       ->getStrategyChoice().findEffectiveStrategy("/prefix");
+    BOOST_CHECK(Name("/localhost/nfd/strategy/multicast").isPrefixOf(strategy.getInstanceName()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MinimalStack)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.enableMinimalStack();
+  ndnHelper.InstallAll();
+
+  Ptr<L3Protocol> l3 = L3Protocol::getL3Protocol(nodes.Get(0));
+  BOOST_CHECK(!l3->isManagementEnabled());
+  BOOST_CHECK(l3->getFibManager() == nullptr);
+  BOOST_CHECK(L3Protocol::getL3Protocol(nodes.Get(1))->getConfig().get<bool>("ndnSIM.minimal_stack"));
+  // settings of the helper are not applied to the config shared with other helpers
+  BOOST_CHECK(!L3Protocol::getDefaultConfig()->get<bool>("ndnSIM.minimal_stack", false));
+
+  FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(1), 5);
+  StrategyChoiceHelper::Install(nodes.Get(0), "/prefix", "/localhost/nfd/strategy/multicast");
+
+  auto& fib = l3->getForwarder()->getFib();
+  const nfd::fib::Entry* entry = fib.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(&entry->getNextHops().front().getFace(),
+                    l3->getFaceByNetDevice(nodes.Get(0)->GetDevice(0)).get());
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 5);
+
+  auto& strategy = l3->getForwarder()->getStrategyChoice().findEffectiveStrategy("/prefix");
+  BOOST_CHECK(Name("/localhost/nfd/strategy/multicast").isPrefixOf(strategy.getInstanceName()));
+
+  FibHelper::RemoveRoute(nodes.Get(0), "/prefix", l3->getFaceByNetDevice(nodes.Get(0)->GetDevice(0)));
+  BOOST_CHECK(fib.findExactMatch("/prefix") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
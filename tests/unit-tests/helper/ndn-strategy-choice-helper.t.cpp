@@ -29,8 +29,13 @@ namespace ndn {
 class StrategyChoiceHelperFixture : public ScenarioHelperWithCleanupFixture
 {
 public:
-  StrategyChoiceHelperFixture()
+  explicit
+  StrategyChoiceHelperFixture(bool isMinimal = false)
   {
+    if (isMinimal) {
+      getStackHelper().enableMinimalStack();
+    }
+
     Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
     Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
     Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("500p"));
@@ -74,6 +79,15 @@ public:
   }
 };
 
+class MinimalStackFixture : public StrategyChoiceHelperFixture
+{
+public:
+  MinimalStackFixture()
+    : StrategyChoiceHelperFixture(true)
+  {
+  }
+};
+
 BOOST_FIXTURE_TEST_SUITE(TestStrategyChoiceHelper, StrategyChoiceHelperFixture)
 
 BOOST_AUTO_TEST_CASE(DefaultStrategies)
@@ -140,6 +154,38 @@ BOOST_AUTO_TEST_CASE(InstallAllBuiltInStrategy)
   BOOST_CHECK_EQUAL(getFace("A2", "C2")->getCounters().nOutInterests, 5);
 }
 
+// nodes without StrategyChoice manager, both overloads update StrategyChoice table directly
+BOOST_FIXTURE_TEST_CASE(InstallBuiltInStrategyOnNodeMinimalStack, MinimalStackFixture)
+{
+  StrategyChoiceHelper::Install(getNode("A2"), "/prefix", "/localhost/nfd/strategy/multicast");
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("A1", "B1")->getCounters().nOutInterests, 0);
+  BOOST_CHECK_EQUAL(getFace("A1", "C1")->getCounters().nOutInterests, 5);
+
+  BOOST_CHECK_EQUAL(getFace("A2", "B2")->getCounters().nOutInterests, 5);
+  BOOST_CHECK_EQUAL(getFace("A2", "C2")->getCounters().nOutInterests, 5);
+}
+
+BOOST_FIXTURE_TEST_CASE(InstallBuiltInStrategyOnNodeContainerMinimalStack, MinimalStackFixture)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("A1"));
+  nodes.Add(getNode("A2"));
+
+  StrategyChoiceHelper::Install(nodes, "/prefix", "/localhost/nfd/strategy/multicast");
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("A1", "B1")->getCounters().nOutInterests, 5);
+  BOOST_CHECK_EQUAL(getFace("A1", "C1")->getCounters().nOutInterests, 5);
+
+  BOOST_CHECK_EQUAL(getFace("A2", "B2")->getCounters().nOutInterests, 5);
+  BOOST_CHECK_EQUAL(getFace("A2", "C2")->getCounters().nOutInterests, 5);
+}
 
 class NullStrategy : public nfd::fw::Strategy {
 public:
@@ -91,6 +91,35 @@ BOOST_AUTO_TEST_CASE(EncodePrintData)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Deserialize)
+{
+  for (size_t payloadSize : {0, 64, 300, 70000}) {
+    Data data("/other/prefix");
+    data.setContent(std::make_shared< ::ndn::Buffer>(payloadSize));
+    ndn::StackHelper::getKeyChain().sign(data);
+    lp::Packet lpPacket(data.wireEncode());
+    Block wire = lpPacket.wireEncode();
+
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(BlockHeader(nfd::face::Transport::Packet(Block(wire))));
+
+    BlockHeader header;
+    BOOST_CHECK_EQUAL(packet->PeekHeader(header), wire.size());
+    BOOST_CHECK_EQUAL_COLLECTIONS(header.getBlock().begin(), header.getBlock().end(),
+                                  wire.begin(), wire.end());
+    BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DeserializeTruncated)
+{
+  Block wire = "0605 0703 0801 41"_block;
+
+  Ptr<Packet> packet = Create<Packet>(wire.wire(), wire.size() - 1);
+  BlockHeader header;
+  BOOST_CHECK_THROW(packet->PeekHeader(header), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(PrintLpPacket)
 {
   Interest interest("/prefix");
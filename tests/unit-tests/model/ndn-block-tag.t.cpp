@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "model/ndn-block-tag.hpp"
+#include "model/ndn-net-device-transport.hpp"
+#include "model/ndn-block-header.hpp"
+#include "helper/ndn-link-control-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnBlockTag, ScenarioHelperWithCleanupFixture)
+
+BOOST_AUTO_TEST_CASE(CreatePacket)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  interest.setCanBePrefix(true);
+  Block block = interest.wireEncode();
+
+  Ptr<ns3::Packet> packet = BlockTag::CreatePacket(block);
+  BOOST_CHECK_EQUAL(packet->GetSize(), block.size());
+
+  // copies of the packet refer to the same buffer
+  auto received = BlockTag::GetBlock(*packet->Copy());
+  BOOST_REQUIRE(received);
+  BOOST_CHECK(received->wire() == block.wire());
+  BOOST_CHECK_EQUAL(Interest(*received).getName(), Name("/prefix"));
+
+  // the only receiver got the block, so it is released, and the virtual payload has no wire
+  BOOST_CHECK(!BlockTag::GetBlock(*packet));
+
+  // packets without BlockTag are decoded
+  Ptr<ns3::Packet> serialized = Create<ns3::Packet>();
+  serialized->AddHeader(BlockHeader(nfdFace::Transport::Packet(Block(block))));
+  received = BlockTag::GetBlock(*serialized);
+  BOOST_REQUIRE(received);
+  BOOST_CHECK(*received == block);
+}
+
+BOOST_AUTO_TEST_CASE(SeveralReceivers)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  interest.setCanBePrefix(true);
+  Block block = interest.wireEncode();
+
+  Ptr<ns3::Packet> packet = BlockTag::CreatePacket(block, 3);
+  BOOST_CHECK_EQUAL(packet->GetSize(), block.size());
+
+  auto received = BlockTag::GetBlock(*packet->Copy());
+  BOOST_REQUIRE(received);
+  BOOST_CHECK(received->wire() == block.wire());
+
+  BlockTag::Drop(*packet->Copy());
+
+  received = BlockTag::GetBlock(*packet->Copy());
+  BOOST_REQUIRE(received);
+  BOOST_CHECK(received->wire() == block.wire());
+
+  // all receivers are counted, so the block is released and decoded from the wire encoding
+  received = BlockTag::GetBlock(*packet->Copy());
+  BOOST_REQUIRE(received);
+  BOOST_CHECK(received->wire() != block.wire());
+  BOOST_CHECK(*received == block);
+
+  packet = BlockTag::CreatePacket(block, 3);
+  BlockTag::Release(*packet);
+  received = BlockTag::GetBlock(*packet);
+  BOOST_REQUIRE(received);
+  BOOST_CHECK(received->wire() != block.wire());
+  BOOST_CHECK(*received == block);
+}
+
+BOOST_AUTO_TEST_CASE(PointerPassing)
+{
+  getStackHelper().enablePointerPassing();
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"}
+    });
+
+  // node 3 serializes packets, so both forms are exchanged on the 2-3 link
+  dynamic_cast<NetDeviceTransport*>(getFace("3", "2")->getTransport())->SetPointerPassing(false);
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"2", "3", "/prefix", 1}
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "0.95s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nOutInterests, 10);
+  BOOST_CHECK_EQUAL(getFace("3", "2")->getCounters().nInInterests, 10);
+  BOOST_CHECK_EQUAL(getFace("3", "2")->getCounters().nOutData, 10);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 10);
+
+  // every block has been received
+  BOOST_CHECK_EQUAL(BlockTag::GetNBlocks(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DroppedPackets)
+{
+  getStackHelper().enablePointerPassing();
+
+  createTopology({
+      {"1", "2"},
+      {"1", "3"}
+    });
+
+  // node 3 does not follow drops of its device
+  dynamic_cast<NetDeviceTransport*>(getFace("3", "1")->getTransport())->SetPointerPassing(false);
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"1", "3", "/prefix", 1}
+    });
+
+  StrategyChoiceHelper::Install(getNode("1"), "/prefix", "/localhost/nfd/strategy/multicast");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "0.95s"},
+    });
+
+  LinkControlHelper::FailLink(getNode("1"), getNode("2"));
+  LinkControlHelper::FailLink(getNode("1"), getNode("3"));
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nOutInterests, 10);
+  BOOST_CHECK_EQUAL(getFace("1", "3")->getCounters().nOutInterests, 10);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 0);
+
+  // blocks dropped by node 2 are released right away, those dropped by node 3 wait for lifetime
+  BOOST_CHECK_EQUAL(BlockTag::GetNBlocks(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-geocast-region.hpp"
+#include "model/directed-geocast-strategy.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+#include "apps/ndn-app.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(ModelNdnGeocastRegion)
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  GeocastRegion region(Vector(-1.5, 2, 0), Vector(700.25, 0, 3), 100);
+
+  Name name("/v2safety/8thStreet");
+  name.append(region.toNameComponent());
+  name.appendSequenceNumber(5);
+
+  auto decoded = GeocastRegion::fromName(name);
+  BOOST_REQUIRE(decoded);
+  BOOST_CHECK_EQUAL(decoded->source, region.source);
+  BOOST_CHECK_EQUAL(decoded->destination, region.destination);
+  BOOST_CHECK_EQUAL(decoded->limit, region.limit);
+
+  // survives wire encoding
+  decoded = GeocastRegion::fromName(Name(name.wireEncode()));
+  BOOST_REQUIRE(decoded);
+  BOOST_CHECK_EQUAL(decoded->destination, region.destination);
+}
+
+BOOST_AUTO_TEST_CASE(LegacyName)
+{
+  auto decoded = GeocastRegion::fromName(Name("/v2safety/8thStreet/0,0,0/300.000000,10,0/100/%FE%01"));
+  BOOST_REQUIRE(decoded);
+  BOOST_CHECK_EQUAL(decoded->source, Vector(0, 0, 0));
+  BOOST_CHECK_EQUAL(decoded->destination, Vector(300, 10, 0));
+  BOOST_CHECK_EQUAL(decoded->limit, 100);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK(!GeocastRegion::fromName(Name("/a/b")));
+  BOOST_CHECK(!GeocastRegion::fromName(Name("/prefix/0,0/300,0,0/100/1")));
+  BOOST_CHECK(!GeocastRegion::fromName(Name("/prefix/0,0,0,0,0,0/300,0,0/100/1")));
+  BOOST_CHECK(!GeocastRegion::fromName(Name("/prefix/0,0,0/300,0,0/abc/1")));
+  BOOST_CHECK(!GeocastRegion::fromName(Name("/prefix/x,y,z/300,0,0/100/1")));
+
+  // typed component with a wrong length
+  Name name("/prefix");
+  name.append(name::Component(GeocastRegion::NAME_COMPONENT_TYPE,
+                              reinterpret_cast<const uint8_t*>("abc"), 3));
+  BOOST_CHECK(!GeocastRegion::fromName(name));
+}
+
+BOOST_AUTO_TEST_CASE(TypedPrefix)
+{
+  Name prefix = GeocastRegion::toTypedPrefix(Name("/v2safety/8thStreet/0,0,0/200,0,0/100"));
+  BOOST_REQUIRE_EQUAL(prefix.size(), 3);
+  BOOST_CHECK_EQUAL(prefix.getPrefix(2), Name("/v2safety/8thStreet"));
+  BOOST_CHECK_EQUAL(prefix.get(2).type(), GeocastRegion::NAME_COMPONENT_TYPE);
+
+  auto decoded = GeocastRegion::fromNameComponent(prefix.get(2));
+  BOOST_REQUIRE(decoded);
+  BOOST_CHECK_EQUAL(decoded->destination, Vector(200, 0, 0));
+  BOOST_CHECK_EQUAL(decoded->limit, 100);
+
+  // already converted or not carrying a region
+  BOOST_CHECK_EQUAL(GeocastRegion::toTypedPrefix(prefix), prefix);
+  BOOST_CHECK_EQUAL(GeocastRegion::toTypedPrefix(Name("/v2safety/8thStreet")),
+                    Name("/v2safety/8thStreet"));
+}
+
+class GeocastRegionScenarioFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  onData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    dataNames.push_back(data->getName());
+  }
+
+public:
+  std::vector<Name> actionNames;
+  std::vector<Name> dataNames;
+};
+
+BOOST_FIXTURE_TEST_CASE(ThroughStrategy, GeocastRegionScenarioFixture)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/v2safety", 1},
+    });
+
+  StrategyChoiceHelper::InstallAll("/v2safety",
+                                   nfd::fw::DirectedGeocastStrategy::getStrategyName());
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/v2safety/8thStreet/0,0,0/200,0,0/100"}, {"TypedGeocastRegion", "true"},
+           {"Frequency", "1"}},
+          "0s", "0.9s"}, // send just one packet
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/v2safety/8thStreet"}, {"PayloadSize", "100"}},
+          "0s", "100s"},
+    });
+
+  ::ndn::util::signal::ScopedConnection connection =
+    nfd::fw::DirectedGeocastStrategy::onAction.connect([this] (const Name& name, int, double,
+                                                               double) {
+        actionNames.push_back(name);
+      });
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::App/ReceivedDatas",
+                                MakeCallback(&GeocastRegionScenarioFixture::onData, this));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  // received and sent by the consumer's node, then received by the producer's node
+  BOOST_REQUIRE_GE(actionNames.size(), 3);
+  for (const Name& name : actionNames) {
+    BOOST_REQUIRE_EQUAL(name.size(), 4);
+    BOOST_CHECK_EQUAL(name.get(2).type(), GeocastRegion::NAME_COMPONENT_TYPE);
+
+    auto decoded = GeocastRegion::fromName(name);
+    BOOST_REQUIRE(decoded);
+    BOOST_CHECK_EQUAL(decoded->source, Vector(0, 0, 0));
+    BOOST_CHECK_EQUAL(decoded->destination, Vector(200, 0, 0));
+    BOOST_CHECK_EQUAL(decoded->limit, 100);
+  }
+
+  // Data comes back under the same name
+  BOOST_REQUIRE_EQUAL(dataNames.size(), 1);
+  BOOST_CHECK_EQUAL(dataNames[0], actionNames[0]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
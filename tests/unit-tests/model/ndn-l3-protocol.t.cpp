@@ -19,6 +19,12 @@
 
 #include "helper/ndn-scenario-helper.hpp"
 #include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-net-device-transport.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/point-to-point-helper.h"
+#include "ns3/csma-helper.h"
 
 #include <ndn-cxx/face.hpp>
 
@@ -124,6 +130,130 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
 
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+BOOST_AUTO_TEST_CASE(FaceIndex)
+{
+  createTopology({
+      {"1", "2"},
+      {"1", "3"}
+    });
+
+  Ptr<L3Protocol> ndn = getNode("1")->GetObject<L3Protocol>();
+  shared_ptr<Face> face = getFace("1", "3");
+  Ptr<NetDevice> netDevice = dynamic_cast<NetDeviceTransport*>(face->getTransport())->GetNetDevice();
+
+  BOOST_CHECK(ndn->getFaceByNetDevice(netDevice) == face);
+  BOOST_REQUIRE_EQUAL(ndn->getFacesByNeighbor(getNode("3")).size(), 1);
+  BOOST_CHECK(ndn->getFacesByNeighbor(getNode("3")).front() == face);
+  BOOST_REQUIRE_EQUAL(ndn->getFacesByNeighbor(getNode("2")).size(), 1);
+  BOOST_CHECK(ndn->getFacesByNeighbor(getNode("2")).front() == getFace("1", "2"));
+  BOOST_CHECK(ndn->getFaceByNetDevice(getNetDevice("2", "1")) == nullptr);
+
+  face->close();
+  // FaceTable removes closed faces asynchronously
+  Simulator::Stop(Seconds(0.1));
+  Simulator::Run();
+
+  BOOST_CHECK(ndn->getFaceByNetDevice(netDevice) == nullptr);
+  BOOST_CHECK(ndn->getFacesByNeighbor(getNode("3")).empty());
+  BOOST_CHECK(ndn->getFaceByNetDevice(getNetDevice("1", "2")) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(FaceIndexParallelLinks)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  // two parallel point-to-point links between nodes 0 and 1
+  PointToPointHelper p2p;
+  NetDeviceContainer link1 = p2p.Install(nodes.Get(0), nodes.Get(1));
+  NetDeviceContainer link2 = p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  // a two-device CSMA segment between nodes 0 and 2 is not a point-to-point link
+  CsmaHelper csma;
+  csma.Install(NodeContainer(nodes.Get(0), nodes.Get(2)));
+
+  StackHelper ndnHelper;
+  ndnHelper.enableMinimalStack();
+  ndnHelper.Install(nodes);
+
+  Ptr<L3Protocol> ndn = nodes.Get(0)->GetObject<L3Protocol>();
+  auto faces = ndn->getFacesByNeighbor(nodes.Get(1));
+  BOOST_REQUIRE_EQUAL(faces.size(), 2);
+  BOOST_CHECK(faces[0] == ndn->getFaceByNetDevice(link1.Get(0)));
+  BOOST_CHECK(faces[1] == ndn->getFaceByNetDevice(link2.Get(0)));
+  BOOST_CHECK_LT(faces[0]->getId(), faces[1]->getId());
+
+  BOOST_CHECK(ndn->getFacesByNeighbor(nodes.Get(2)).empty());
+
+  // routes to a neighbor with parallel links use the first link
+  FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(1), 1);
+  const nfd::fib::Entry* entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getFace().getId(), faces[0]->getId());
+}
+
+class FaceTraceCounter
+{
+public:
+  void
+  onInterest(const Interest&, const Face& face)
+  {
+    ++counts[face.getId()];
+  }
+
+public:
+  std::map<nfd::FaceId, uint64_t> counts;
+};
+
+BOOST_AUTO_TEST_CASE(LazyFaceTraces)
+{
+  createTopology({
+      {"1", "2"}
+    });
+  addRoutes({
+      {"1", "2", "/prefix", 1}
+    });
+
+  Ptr<L3Protocol> ndn = getNode("1")->GetObject<L3Protocol>();
+
+  // connected before the application face is added
+  FaceTraceCounter inInterests;
+  ndn->TraceConnectWithoutContext("InInterests",
+                                  MakeCallback(&FaceTraceCounter::onInterest, &inInterests));
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+
+  // connected while packets are flowing
+  FaceTraceCounter outInterests;
+  uint64_t nOutInterestsBefore = 0;
+  Simulator::Schedule(Seconds(1.05), [&] {
+      nOutInterestsBefore = getFace("1", "2")->getCounters().nOutInterests;
+      ndn->TraceConnectWithoutContext("OutInterests",
+                                      MakeCallback(&FaceTraceCounter::onInterest, &outInterests));
+    });
+
+  Simulator::Stop(Seconds(2.05));
+  Simulator::Run();
+
+  // only the consumer's face receives Interests
+  BOOST_REQUIRE_EQUAL(inInterests.counts.size(), 1);
+  auto appFace = inInterests.counts.begin();
+  BOOST_CHECK_EQUAL(appFace->second, ndn->getFaceById(appFace->first)->getCounters().nInInterests);
+
+  uint64_t nOutInterests = outInterests.counts[getFace("1", "2")->getId()];
+  BOOST_CHECK_GT(nOutInterests, 0);
+  BOOST_CHECK_EQUAL(nOutInterests,
+                    getFace("1", "2")->getCounters().nOutInterests - nOutInterestsBefore);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
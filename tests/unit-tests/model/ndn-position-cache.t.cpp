@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-position-cache.hpp"
+
+#include "ns3/node.h"
+#include "ns3/constant-velocity-mobility-model.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class PositionCacheFixture : public CleanupFixture
+{
+public:
+  PositionCacheFixture()
+    : node(CreateObject<Node>())
+    , mobility(CreateObject<ConstantVelocityMobilityModel>())
+  {
+    mobility->SetPosition(Vector(10, 20, 0));
+    mobility->SetVelocity(Vector(1, 0, 0));
+  }
+
+public:
+  Ptr<Node> node;
+  Ptr<ConstantVelocityMobilityModel> mobility;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnPositionCache, PositionCacheFixture)
+
+BOOST_AUTO_TEST_CASE(NoMobility)
+{
+  auto cache = PositionCache::getPositionCache(node);
+  BOOST_CHECK(!cache->GetPosition());
+
+  // mobility can be aggregated after the cache
+  node->AggregateObject(mobility);
+  BOOST_REQUIRE(cache->GetPosition());
+  BOOST_CHECK_EQUAL(cache->GetPosition()->x, 10);
+
+  BOOST_CHECK_EQUAL(PositionCache::getPositionCache(node), cache);
+}
+
+BOOST_AUTO_TEST_CASE(TimeQuantum)
+{
+  node->AggregateObject(mobility);
+  auto cache = PositionCache::getPositionCache(node);
+  cache->SetAttribute("TimeQuantum", TimeValue(Seconds(1)));
+
+  BOOST_CHECK_EQUAL(cache->GetPosition()->x, 10);
+
+  Simulator::Schedule(Seconds(0.5), [=] {
+      // still within the quantum
+      BOOST_CHECK_EQUAL(cache->GetPosition()->x, 10);
+    });
+  Simulator::Schedule(Seconds(1.5), [=] {
+      BOOST_CHECK_CLOSE(cache->GetPosition()->x, 11.5, 0.001);
+    });
+  Simulator::Schedule(Seconds(2.0), [=] {
+      // CourseChange invalidates the cache
+      mobility->SetPosition(Vector(100, 0, 0));
+      BOOST_CHECK_EQUAL(cache->GetPosition()->x, 100);
+    });
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_CASE(DefaultQuantum)
+{
+  node->AggregateObject(mobility);
+  auto cache = PositionCache::getPositionCache(node);
+
+  Simulator::Schedule(Seconds(0.5), [=] {
+      BOOST_CHECK_CLOSE(cache->GetPosition()->x, 10.5, 0.001);
+    });
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-spatial-index.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/constant-velocity-mobility-model.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class SpatialIndexFixture : public CleanupFixture
+{
+public:
+  SpatialIndexFixture()
+  {
+    // 10x10 grid with 50 m spacing
+    nodes.Create(100);
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+      auto mobility = CreateObject<ConstantVelocityMobilityModel>();
+      mobility->SetPosition(Vector(50.0 * (i % 10), 50.0 * (i / 10), 0));
+      nodes.Get(i)->AggregateObject(mobility);
+    }
+
+    SpatialIndex::Get().SetCellSize(100);
+    SpatialIndex::Get().Install(nodes);
+  }
+
+  std::set<uint32_t>
+  bruteForce(const Vector& center, double radius)
+  {
+    std::set<uint32_t> ids;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+      auto pos = nodes.Get(i)->GetObject<MobilityModel>()->GetPosition();
+      if (CalculateDistance(center, pos) <= radius) {
+        ids.insert(nodes.Get(i)->GetId());
+      }
+    }
+    return ids;
+  }
+
+  static std::set<uint32_t>
+  toIds(const SpatialIndex::NodeDistanceList& list)
+  {
+    std::set<uint32_t> ids;
+    for (const auto& item : list) {
+      ids.insert(item.second->GetId());
+    }
+    return ids;
+  }
+
+public:
+  NodeContainer nodes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnSpatialIndex, SpatialIndexFixture)
+
+BOOST_AUTO_TEST_CASE(Range)
+{
+  BOOST_CHECK_EQUAL(SpatialIndex::Get().size(), 100);
+
+  for (double radius : {0.0, 10.0, 75.0, 160.0, 1000.0}) {
+    Vector center(120, 180, 0);
+    auto result = SpatialIndex::Get().FindInRange(center, radius);
+    BOOST_CHECK(toIds(result) == bruteForce(center, radius));
+    BOOST_CHECK(std::is_sorted(result.begin(), result.end(),
+                               [] (const SpatialIndex::NodeDistanceList::value_type& a,
+                                   const SpatialIndex::NodeDistanceList::value_type& b) {
+                                 return a.first < b.first;
+                               }));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Nearest)
+{
+  auto result = SpatialIndex::Get().FindNearest(Vector(101, 99, 0), 1);
+  BOOST_REQUIRE_EQUAL(result.size(), 1);
+  BOOST_CHECK_EQUAL(result[0].second->GetId(), nodes.Get(22)->GetId());
+
+  BOOST_CHECK_EQUAL(SpatialIndex::Get().FindNearest(Vector(-5000, 0, 0), 5).size(), 5);
+  BOOST_CHECK_EQUAL(SpatialIndex::Get().FindNearest(Vector(0, 0, 0), 500).size(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(NonFinitePositions)
+{
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  double inf = std::numeric_limits<double>::infinity();
+
+  // beyond the 32-bit cell range
+  nodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(1e15, -1e15, 0));
+  BOOST_CHECK(toIds(SpatialIndex::Get().FindInRange(Vector(1e15, -1e15, 0), 1)) ==
+              std::set<uint32_t>{nodes.Get(0)->GetId()});
+
+  nodes.Get(1)->GetObject<MobilityModel>()->SetPosition(Vector(nan, 0, 0));
+  BOOST_CHECK_EQUAL(SpatialIndex::Get().FindNearest(Vector(0, 0, 0), 100).size(), 99);
+  BOOST_CHECK_EQUAL(SpatialIndex::Get().FindNearest(Vector(0, 0, 0), 1000).size(), 99);
+
+  BOOST_CHECK_EQUAL(SpatialIndex::Get().FindNearest(Vector(nan, 0, 0), 5).size(), 0);
+  BOOST_CHECK_EQUAL(SpatialIndex::Get().FindInRange(Vector(0, inf, 0), 100).size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Movement)
+{
+  auto mobility = nodes.Get(0)->GetObject<ConstantVelocityMobilityModel>();
+
+  // course change
+  mobility->SetPosition(Vector(1000, 1000, 0));
+  BOOST_CHECK(toIds(SpatialIndex::Get().FindInRange(Vector(1000, 1000, 0), 1)) ==
+              std::set<uint32_t>{nodes.Get(0)->GetId()});
+
+  // continuous movement without course changes
+  mobility->SetVelocity(Vector(40, 0, 0));
+  SpatialIndex::Get().SetRebinInterval(Seconds(10));
+
+  Simulator::Schedule(Seconds(5), [this] {
+      Vector center(1200, 1000, 0);
+      BOOST_CHECK(toIds(SpatialIndex::Get().FindInRange(center, 1)) == bruteForce(center, 1));
+      BOOST_CHECK(toIds(SpatialIndex::Get().FindInRange(center, 1)).size() == 1);
+    });
+
+  Simulator::Stop(Seconds(6));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
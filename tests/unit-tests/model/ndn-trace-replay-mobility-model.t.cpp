@@ -0,0 +1,284 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-trace-replay-mobility-model.hpp"
+#include "helper/ndn-trace-replay-mobility-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/node-container.h"
+
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <fstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "mobility.tcl";
+const boost::filesystem::path TEST_FCD = boost::filesystem::path(TEST_CONFIG_PATH) / "fcd.xml";
+
+class TraceReplayFixture : public CleanupFixture
+{
+public:
+  TraceReplayFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    std::ofstream os(TEST_TRACE.string().c_str());
+    os << "$node_(0) set X_ 1\n"
+       << "$node_(0) set Y_ 2\n"
+       << "$node_(0) set Z_ 1.5\n"
+       << "$node_(1) set X_ 100\n"
+       << "$ns_ at 1.5 \"$node_(1) setdest 100 0 0 0\"\n"
+       << "$ns_ at 1 \"$node_(0) setdest 10 0 10 0\"\n"
+       << "# continues the previous movement\n"
+       << "$ns_ at 2 \"$node_(0) setdest 20 0 10 0\"\n"
+       << "$ns_ at 3 \"$node_(0) setdest 30 0 10 90\"\n"
+       << "$ns_ at 5 \"$node_(1) setdest 100 0 2 180\"\n"
+       << "$ns_ at x \"$node_(1) setdest 1 2 3 4\"\n"; // malformed
+
+    // vehicles a and c drive at the same time, b departs after a arrives
+    std::ofstream fcd(TEST_FCD.string().c_str());
+    fcd << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<!-- <vehicle id=\"commented\"/> -->\n"
+        << "<fcd-export>\n"
+        << "  <timestep time=\"0.00\">\n"
+        << "    <vehicle id=\"a\" x=\"0\" y=\"0\" angle=\"90\" type=\"car\" speed=\"10\"/>\n"
+        << "    <vehicle id=\"c\" x=\"0\" y=\"0\" angle=\"0\" type=\"car\" speed=\"10\"/>\n"
+        << "  </timestep>\n"
+        << "  <timestep time=\"1.00\">\n"
+        << "    <vehicle id=\"a\" x=\"10\" y=\"0\" angle=\"90\" type=\"car\" speed=\"10\"/>\n"
+        << "    <vehicle id=\"c\" x=\"0\" y=\"10\" angle=\"0\" type=\"car\" speed=\"10\"/>\n"
+        << "  </timestep>\n"
+        << "  <timestep time=\"2.00\">\n"
+        << "    <vehicle id=\"b\" x=\"5\" y=\"5\" z=\"2\" angle=\"180\" speed=\"3\"/>\n"
+        << "    <vehicle id=\"c\" x=\"0\" y=\"20\" angle=\"0\" type=\"car\" speed=\"10\"/>\n"
+        << "  </timestep>\n"
+        << "  <timestep time=\"3.00\">\n"
+        << "    <vehicle id=\"b\" x=\"5\" y=\"2\" z=\"2\" angle=\"180\" speed=\"3\"/>\n"
+        << "  </timestep>\n"
+        << "</fcd-export>\n";
+  }
+
+  ~TraceReplayFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_FCD);
+  }
+
+  void
+  courseChanged(Ptr<const MobilityModel> model)
+  {
+    courseChanges.push_back(std::make_pair(Simulator::Now(), model->GetPosition()));
+    courseChangeContexts.push_back(Simulator::GetContext());
+  }
+
+  void
+  checkPosition(Ptr<Node> node, const Vector& expected)
+  {
+    Vector position = node->GetObject<MobilityModel>()->GetPosition();
+    BOOST_CHECK_SMALL(position.x - expected.x, 1e-6);
+    BOOST_CHECK_SMALL(position.y - expected.y, 1e-6);
+    BOOST_CHECK_SMALL(position.z - expected.z, 1e-6);
+  }
+
+public:
+  std::vector<std::pair<Time, Vector>> courseChanges;
+  std::vector<uint32_t> courseChangeContexts;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnTraceReplayMobilityModel, TraceReplayFixture)
+
+BOOST_AUTO_TEST_CASE(Load)
+{
+  auto table = WaypointTable::LoadNs2(TEST_TRACE.string());
+  BOOST_CHECK_EQUAL(table->GetNTracks(), 2);
+  BOOST_CHECK_EQUAL(table->GetNWaypoints(), 5);
+  BOOST_CHECK(table->HasTrack(0));
+  BOOST_CHECK(!table->HasTrack(2));
+
+  BOOST_CHECK_THROW(WaypointTable::LoadNs2(TEST_CONFIG_PATH "/nonexistent.tcl"),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  TraceReplayMobilityHelper helper(TEST_TRACE.string());
+  helper.Install(nodes);
+  BOOST_CHECK(nodes.Get(2)->GetObject<MobilityModel>() == 0);
+
+  nodes.Get(0)->GetObject<MobilityModel>()->TraceConnectWithoutContext("CourseChange",
+    MakeCallback(&TraceReplayFixture::courseChanged, this));
+
+  Simulator::Schedule(Seconds(0.5), [&] {
+      checkPosition(nodes.Get(0), Vector(1, 2, 1.5));
+      checkPosition(nodes.Get(1), Vector(100, 0, 0));
+    });
+  Simulator::Schedule(Seconds(2.5), [&] {
+      checkPosition(nodes.Get(0), Vector(25, 0, 1.5));
+    });
+  Simulator::Schedule(Seconds(4), [&] {
+      checkPosition(nodes.Get(0), Vector(30, 10, 1.5));
+      BOOST_CHECK_SMALL(nodes.Get(0)->GetObject<MobilityModel>()->GetVelocity().y - 10, 1e-6);
+    });
+  Simulator::Schedule(Seconds(6), [&] {
+      checkPosition(nodes.Get(1), Vector(98, 0, 0));
+    });
+
+  Simulator::Stop(Seconds(7));
+  Simulator::Run();
+
+  // waypoint at 2s continues the previous movement
+  BOOST_REQUIRE_EQUAL(courseChanges.size(), 2);
+  BOOST_CHECK_EQUAL(courseChanges[0].first, Seconds(1));
+  BOOST_CHECK_EQUAL(courseChanges[1].first, Seconds(3));
+  BOOST_CHECK_SMALL(courseChanges[1].second.x - 30, 1e-6);
+
+  // notifications run in the context of the node
+  BOOST_CHECK_EQUAL(courseChangeContexts[0], nodes.Get(0)->GetId());
+  BOOST_CHECK_EQUAL(courseChangeContexts[1], nodes.Get(0)->GetId());
+}
+
+BOOST_AUTO_TEST_CASE(SetTrackAgain)
+{
+  NodeContainer nodes;
+  nodes.Create(1);
+
+  TraceReplayMobilityHelper helper(TEST_TRACE.string());
+  helper.Install(nodes);
+
+  Ptr<TraceReplayMobilityModel> model = nodes.Get(0)->GetObject<TraceReplayMobilityModel>();
+  model->TraceConnectWithoutContext("CourseChange",
+                                    MakeCallback(&TraceReplayFixture::courseChanged, this));
+
+  // attaching the same track again must not add a second chain of course changes
+  model->SetTrack(helper.GetWaypointTable(), 0);
+  Simulator::Schedule(Seconds(0.5), [&] {
+      model->SetTrack(helper.GetWaypointTable(), 0);
+    });
+
+  Simulator::Stop(Seconds(7));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(courseChanges.size(), 4);
+  BOOST_CHECK_EQUAL(courseChanges[0].first, Seconds(0));
+  BOOST_CHECK_EQUAL(courseChanges[1].first, Seconds(0.5));
+  BOOST_CHECK_EQUAL(courseChanges[2].first, Seconds(1));
+  BOOST_CHECK_EQUAL(courseChanges[3].first, Seconds(3));
+}
+
+BOOST_AUTO_TEST_CASE(LoadFcd)
+{
+  auto table = WaypointTable::LoadFcd(TEST_FCD.string());
+  BOOST_REQUIRE_EQUAL(table->GetNTracks(), 3);
+  BOOST_CHECK_EQUAL(table->GetNWaypoints(), 7);
+
+  BOOST_CHECK_EQUAL(table->GetTrackName(0), "a");
+  BOOST_CHECK_EQUAL(table->GetDepartureTime(0), 0);
+  BOOST_CHECK_EQUAL(table->GetArrivalTime(0), 2);
+
+  BOOST_CHECK_EQUAL(table->GetTrackName(2), "b");
+  BOOST_CHECK_EQUAL(table->GetDepartureTime(2), 2);
+  BOOST_CHECK(std::isinf(table->GetArrivalTime(2))); // present in the last timestep
+}
+
+BOOST_AUTO_TEST_CASE(InstallOnDemand)
+{
+  std::vector<std::string> events;
+  std::vector<Ptr<Node>> created;
+
+  TraceReplayMobilityHelper helper(TEST_FCD.string());
+  helper.InstallOnDemand([&] (Ptr<Node> node) {
+      created.push_back(node);
+    },
+    [&] (Ptr<Node> node, const std::string& vehicle) {
+      events.push_back("depart " + vehicle);
+    },
+    [&] (Ptr<Node> node, const std::string& vehicle) {
+      events.push_back("arrive " + vehicle);
+    });
+
+  Simulator::Schedule(Seconds(0.5), [&] {
+      BOOST_REQUIRE_EQUAL(created.size(), 2);
+      checkPosition(created[0], Vector(5, 0, 0));
+      checkPosition(created[1], Vector(0, 5, 0));
+    });
+  Simulator::Schedule(Seconds(2.5), [&] {
+      // node of vehicle a is reused for vehicle b
+      checkPosition(created[0], Vector(5, 3.5, 2));
+    });
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(created.size(), 2);
+  BOOST_CHECK((events == std::vector<std::string>{"depart a", "depart c", "arrive a", "depart b",
+                                                  "arrive c"}));
+  checkPosition(created[1], Vector(1e6, 1e6, 0)); // parked
+}
+
+BOOST_AUTO_TEST_CASE(InstallStackOnDemand)
+{
+  StackHelper ndnHelper;
+  AppHelper appHelper("ns3::ndn::Producer");
+  appHelper.SetPrefix("/vehicle");
+
+  std::vector<Ptr<Node>> created;
+  std::vector<uint32_t> contexts;
+
+  TraceReplayMobilityHelper helper(TEST_FCD.string());
+  helper.InstallOnDemand([&] (Ptr<Node> node) {
+      contexts.push_back(Simulator::GetContext());
+      ndnHelper.Install(node);
+      appHelper.Install(node);
+      created.push_back(node);
+    });
+
+  bool isRunning = false;
+  Simulator::Schedule(Seconds(2.5), [&] {
+      isRunning = true;
+      checkPosition(created[0], Vector(5, 3.5, 2));
+    });
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  // installing the stack within the simulation did not stop it at the first departure
+  BOOST_CHECK(isRunning);
+  BOOST_CHECK_EQUAL(Simulator::Now(), Seconds(4));
+
+  BOOST_REQUIRE_EQUAL(created.size(), 2);
+  for (size_t i = 0; i < created.size(); ++i) {
+    BOOST_CHECK_EQUAL(contexts[i], created[i]->GetId());
+    BOOST_CHECK(created[i]->GetObject<L3Protocol>() != nullptr);
+    BOOST_CHECK_EQUAL(created[i]->GetNApplications(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
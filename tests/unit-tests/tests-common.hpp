@@ -22,6 +22,7 @@
 
 #include "ns3/core-module.h"
 #include "model/ndn-global-router.hpp"
+#include "model/ndn-spatial-index.hpp"
 #include "helper/ndn-scenario-helper.hpp"
 
 #include "boost-test.hpp"
@@ -37,6 +38,7 @@ public:
     Simulator::Destroy();
     Names::Clear();
     GlobalRouter::clear();
+    SpatialIndex::clear();
   }
 };
 
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-alias-table.hpp"
+
+#include <cmath>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsAliasTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ZipfMandelbrot)
+{
+  std::vector<double> weights = AliasTable::makeZipfMandelbrotWeights(1000, 0.7, 0.7);
+  double sum = 0;
+  for (double weight : weights) {
+    sum += weight;
+  }
+
+  AliasTable table(weights);
+  BOOST_REQUIRE_EQUAL(table.size(), 1000);
+  for (size_t i = 0; i < table.size(); ++i) {
+    BOOST_CHECK_CLOSE(table.getProbability(i), weights[i] / sum, 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Sample)
+{
+  AliasTable table({0, 3, 1, 0});
+  BOOST_CHECK_CLOSE(table.getProbability(1), 0.75, 1e-9);
+  BOOST_CHECK_EQUAL(table.getProbability(3), 0);
+
+  std::vector<size_t> counts(table.size());
+  const size_t nSamples = 100000;
+  for (size_t i = 0; i < nSamples; ++i) {
+    counts[table.sample((i + 0.5) / nSamples)]++;
+  }
+  BOOST_CHECK_EQUAL(counts[0], 0);
+  BOOST_CHECK_EQUAL(counts[3], 0);
+  BOOST_CHECK_EQUAL(counts[1], 3 * nSamples / 4);
+  BOOST_CHECK_EQUAL(counts[2], nSamples / 4);
+
+  BOOST_CHECK_LT(table.sample(0.0), table.size());
+  BOOST_CHECK_LT(table.sample(std::nextafter(1.0, 0.0)), table.size());
+}
+
+BOOST_AUTO_TEST_CASE(InvalidWeights)
+{
+  BOOST_CHECK_THROW(AliasTable(std::vector<double>{}), std::invalid_argument);
+  BOOST_CHECK_THROW(AliasTable({0, 0}), std::invalid_argument);
+  BOOST_CHECK_THROW(AliasTable({1, -1}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
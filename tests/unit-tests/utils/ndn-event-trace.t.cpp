@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-event-trace.hpp"
+
+#include <sstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsEventTrace, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(CountersAndSink)
+{
+  EventTrace& trace = EventTrace::get();
+  trace.reset();
+
+  uint64_t& counter = trace.getCounter("Test", "Event");
+  BOOST_CHECK_EQUAL(&counter, &trace.getCounter("Test", "Event"));
+  BOOST_CHECK_EQUAL(trace.getCount("Test", "Unknown"), 0);
+
+  ++counter;
+  ++counter;
+  BOOST_CHECK_EQUAL(trace.getCount("Test", "Event"), 2);
+
+  int nEvents = 0;
+  trace.emit("Test", "Event", 1, 2); // no sink
+  trace.setSink([&nEvents] (const EventTrace::Event& event) {
+      ++nEvents;
+      BOOST_CHECK_EQUAL(event.component, std::string("Test"));
+      BOOST_CHECK_EQUAL(event.name, std::string("Event"));
+      BOOST_CHECK_EQUAL(event.value, 10);
+      BOOST_CHECK_EQUAL(event.detail, -1);
+    });
+  trace.emit("Test", "Event", 10, -1);
+  BOOST_CHECK_EQUAL(nEvents, 1);
+
+  std::ostringstream os;
+  trace.printCounters(os);
+  BOOST_CHECK_NE(os.str().find("Test\tEvent\t2\n"), std::string::npos);
+
+  trace.reset();
+  trace.emit("Test", "Event", 10, -1);
+  BOOST_CHECK_EQUAL(nEvents, 1);
+  BOOST_CHECK_EQUAL(trace.getCount("Test", "Event"), 0);
+  BOOST_CHECK_EQUAL(&counter, &trace.getCounter("Test", "Event"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-ns2-trace-line.hpp"
+
+#include <cstring>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+static Ns2TraceLine
+parse(const char* line)
+{
+  return Ns2TraceLine::Parse(line, line + std::strlen(line));
+}
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNs2TraceLine, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Recognized)
+{
+  BOOST_CHECK_EQUAL(parse("").type, Ns2TraceLine::EMPTY);
+  BOOST_CHECK_EQUAL(parse("  # comment").type, Ns2TraceLine::EMPTY);
+
+  Ns2TraceLine line = parse("$node_(4) set Y_ 11.5");
+  BOOST_CHECK_EQUAL(line.type, Ns2TraceLine::SET);
+  BOOST_CHECK(!line.isScheduled);
+  BOOST_CHECK_EQUAL(line.node, 4);
+  BOOST_CHECK_EQUAL(line.coordinate, 1);
+  BOOST_CHECK_EQUAL(line.value, 11.5);
+
+  line = parse("$ns_ at 4.25 \"$node_(2) set Z_ 28\"");
+  BOOST_CHECK_EQUAL(line.type, Ns2TraceLine::SET);
+  BOOST_CHECK(line.isScheduled);
+  BOOST_CHECK_EQUAL(line.time, 4.25);
+  BOOST_CHECK_EQUAL(line.node, 2);
+  BOOST_CHECK_EQUAL(line.coordinate, 2);
+  BOOST_CHECK_EQUAL(line.value, 28);
+
+  line = parse("$ns_ at 1 \"$node_(0) setdest 2 3 4 90\"\r");
+  BOOST_CHECK_EQUAL(line.type, Ns2TraceLine::SETDEST);
+  BOOST_CHECK_EQUAL(line.time, 1);
+  BOOST_CHECK_EQUAL(line.node, 0);
+  BOOST_CHECK_EQUAL(line.position.x, 2);
+  BOOST_CHECK_EQUAL(line.position.y, 3);
+  BOOST_CHECK_SMALL(line.velocity.x, 1e-9);
+  BOOST_CHECK_SMALL(line.velocity.y - 4, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK_THROW(parse("$node_(0) set V_ 1"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("$node_() set X_ 1"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("$node_(x) set X_ 1"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("$node_(0) set X_ 1m"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("$ns_ at x \"$node_(1) setdest 1 2 3 4\""), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("$node_(1) setdest 1 2 3 4"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("$ns_ at 1 \"$node_(1) setdest 1 2 3\""), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("$ns_ at 1 \"$node_(1) setdest 1 2 3 4 5\""), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "utils/ndn-rtt-mean-deviation.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsRttMeanDeviation, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(OutOfOrderAcks)
+{
+  Ptr<RttMeanDeviation> rtt = CreateObject<RttMeanDeviation>();
+
+  for (uint32_t seq = 0; seq < 100; ++seq) {
+    Simulator::Schedule(MilliSeconds(seq), [rtt, seq] { rtt->SentSeq(SequenceNumber32(seq), 1); });
+  }
+  // acknowledged in reverse order, each 200 ms after sending
+  for (uint32_t seq = 0; seq < 100; ++seq) {
+    uint32_t acked = 99 - seq;
+    Simulator::Schedule(MilliSeconds(300 + seq), [rtt, acked] {
+        BOOST_CHECK_EQUAL(rtt->AckSeq(SequenceNumber32(acked)), MilliSeconds(300 + 99 - 2 * acked));
+      });
+  }
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  // nothing left to acknowledge
+  BOOST_CHECK_EQUAL(rtt->AckSeq(SequenceNumber32(50)), Seconds(0));
+}
+
+BOOST_AUTO_TEST_CASE(KarnsRule)
+{
+  Ptr<RttMeanDeviation> rtt = CreateObject<RttMeanDeviation>();
+  Time initial = rtt->GetCurrentEstimate();
+
+  Simulator::Schedule(Seconds(0), [rtt] {
+      rtt->SentSeq(SequenceNumber32(1), 1);
+      rtt->SentSeq(SequenceNumber32(2), 1);
+    });
+  Time backedOffRto;
+  Simulator::Schedule(Seconds(1), [rtt, &backedOffRto] {
+      rtt->IncreaseMultiplier();
+      backedOffRto = rtt->RetransmitTimeout();
+      rtt->SentSeq(SequenceNumber32(1), 1); // retransmission
+    });
+  Simulator::Schedule(Seconds(2), [rtt, initial, &backedOffRto] {
+      // ambiguous sample is not used and does not reset the backoff
+      BOOST_CHECK_EQUAL(rtt->AckSeq(SequenceNumber32(1)), Seconds(0));
+      BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), initial);
+      BOOST_CHECK_EQUAL(rtt->RetransmitTimeout(), backedOffRto);
+
+      BOOST_CHECK_EQUAL(rtt->AckSeq(SequenceNumber32(2)), Seconds(2));
+      BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), Seconds(2));
+      BOOST_CHECK(rtt->RetransmitTimeout() != backedOffRto);
+    });
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-seq-window.hpp"
+
+#include <map>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsSeqWindow, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Sequential)
+{
+  SeqWindow<int> window;
+  for (uint32_t seq = 100; seq < 1100; ++seq) {
+    window.insert(seq) = seq;
+    if (seq >= 200) {
+      window.erase(seq - 100); // 100 sequence numbers in flight
+    }
+  }
+  BOOST_CHECK_EQUAL(window.size(), 100);
+  BOOST_CHECK(window.find(999) == nullptr);
+  BOOST_REQUIRE(window.find(1000) != nullptr);
+  BOOST_CHECK_EQUAL(*window.find(1000), 1000);
+  BOOST_REQUIRE(window.find(1099) != nullptr);
+  BOOST_CHECK_EQUAL(*window.find(1099), 1099);
+  BOOST_CHECK(window.find(1100) == nullptr);
+
+  // existing record is returned as is
+  window.insert(1050) = 7;
+  BOOST_CHECK_EQUAL(window.insert(1050), 7);
+  BOOST_CHECK_EQUAL(window.size(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(Sparse)
+{
+  SeqWindow<int> window(64);
+  std::map<uint32_t, int> expected;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    uint32_t seq = (i * 7919) % 1000; // spread over more than the span limit
+    window.insert(seq) = i;
+    expected[seq] = i;
+    if (i % 3 == 0) {
+      uint32_t erased = (i * 104729) % 1000;
+      window.erase(erased);
+      expected.erase(erased);
+    }
+  }
+
+  BOOST_CHECK_EQUAL(window.size(), expected.size());
+  for (uint32_t seq = 0; seq < 1000; ++seq) {
+    auto it = expected.find(seq);
+    int* record = window.find(seq);
+    BOOST_REQUIRE_EQUAL(record != nullptr, it != expected.end());
+    if (record != nullptr) {
+      BOOST_CHECK_EQUAL(*record, it->second);
+    }
+  }
+
+  for (const auto& item : expected) {
+    window.erase(item.first);
+  }
+  BOOST_CHECK(window.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-timer-wheel.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTimerWheel, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ScheduleAndCancel)
+{
+  TimerWheel wheel(MilliSeconds(1));
+  std::vector<std::pair<int, Time>> fired;
+
+  wheel.schedule(MilliSeconds(30), [&] { fired.emplace_back(1, Simulator::Now()); });
+  wheel.schedule(MicroSeconds(9500), [&] { fired.emplace_back(2, Simulator::Now()); });
+  auto canceled = wheel.schedule(MilliSeconds(20), [&] { fired.emplace_back(3, Simulator::Now()); });
+  wheel.schedule(Seconds(2), [&] { fired.emplace_back(4, Simulator::Now()); });
+  BOOST_CHECK_EQUAL(wheel.size(), 4);
+
+  BOOST_CHECK(wheel.isPending(canceled));
+  wheel.cancel(canceled);
+  BOOST_CHECK(!wheel.isPending(canceled));
+  wheel.cancel(canceled); // no-op
+  BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(fired.size(), 3);
+  BOOST_CHECK_EQUAL(fired[0].first, 2);
+  BOOST_CHECK_EQUAL(fired[0].second, MilliSeconds(10)); // rounded up to the resolution
+  BOOST_CHECK_EQUAL(fired[1].first, 1);
+  BOOST_CHECK_EQUAL(fired[1].second, MilliSeconds(30));
+  BOOST_CHECK_EQUAL(fired[2].first, 4);
+  BOOST_CHECK_EQUAL(fired[2].second, Seconds(2));
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScheduleFromCallback)
+{
+  TimerWheel wheel(MilliSeconds(1));
+  int nFired = 0;
+  TimerWheel::TimerId other;
+
+  wheel.schedule(MilliSeconds(5), [&] {
+      ++nFired;
+      wheel.cancel(other);
+      wheel.schedule(MilliSeconds(300), [&] {
+          ++nFired;
+          BOOST_CHECK_EQUAL(Simulator::Now(), MilliSeconds(305));
+        });
+    });
+  other = wheel.schedule(MilliSeconds(5), [&] { BOOST_FAIL("timer should have been canceled"); });
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(nFired, 2);
+}
+
+BOOST_AUTO_TEST_CASE(FarTimer)
+{
+  // beyond the range of all wheel levels
+  TimerWheel wheel(MicroSeconds(1));
+  bool isFired = false;
+  wheel.schedule(Seconds(40), [&] {
+      isFired = true;
+      BOOST_CHECK_EQUAL(Simulator::Now(), Seconds(40));
+    });
+
+  Simulator::Run();
+  BOOST_CHECK(isFired);
+}
+
+BOOST_AUTO_TEST_CASE(FineResolution)
+{
+  // random backoffs as scheduled by DirectedGeocastStrategy keep their order and stay apart
+  TimerWheel wheel(NanoSeconds(100));
+  std::vector<std::pair<int, Time>> fired;
+
+  wheel.schedule(MilliSeconds(20) + NanoSeconds(1250),
+                 [&] { fired.emplace_back(1, Simulator::Now()); });
+  wheel.schedule(MilliSeconds(20) + NanoSeconds(170),
+                 [&] { fired.emplace_back(2, Simulator::Now()); });
+  wheel.schedule(MilliSeconds(20) + NanoSeconds(310),
+                 [&] { fired.emplace_back(3, Simulator::Now()); });
+  wheel.schedule(MilliSeconds(95), [&] { fired.emplace_back(4, Simulator::Now()); });
+
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(fired.size(), 4);
+  BOOST_CHECK_EQUAL(fired[0].first, 2);
+  BOOST_CHECK_EQUAL(fired[0].second, MilliSeconds(20) + NanoSeconds(200));
+  BOOST_CHECK_EQUAL(fired[1].first, 3);
+  BOOST_CHECK_EQUAL(fired[1].second, MilliSeconds(20) + NanoSeconds(400));
+  BOOST_CHECK_EQUAL(fired[2].first, 1);
+  BOOST_CHECK_EQUAL(fired[2].second, MilliSeconds(20) + NanoSeconds(1300));
+  BOOST_CHECK_EQUAL(fired[3].first, 4);
+  BOOST_CHECK_EQUAL(fired[3].second, MilliSeconds(95));
+}
+
+BOOST_AUTO_TEST_CASE(SparseWakeups)
+{
+  // wheel wakes up only for cascades of non-empty slots, not at every first-level boundary
+  TimerWheel wheel(MicroSeconds(1));
+  bool isFired = false;
+  wheel.schedule(Seconds(10), [&] { isFired = true; });
+
+  uint64_t nEventsBefore = Simulator::GetEventCount();
+  Simulator::Run();
+
+  BOOST_CHECK(isFired);
+  BOOST_CHECK_LT(Simulator::GetEventCount() - nEventsBefore, 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-geocast-action-tracer.hpp"
+#include "model/directed-geocast-strategy.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_GEOCAST_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "geocast-trace.bin";
+
+class GeocastActionTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  GeocastActionTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    StrategyChoiceHelper::InstallAll("/prefix", nfd::fw::DirectedGeocastStrategy::getStrategyName());
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0s", "0.9s"}, // send just one packet
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+            "0s", "100s"},
+      });
+  }
+
+  ~GeocastActionTracerFixture()
+  {
+    boost::filesystem::remove(TEST_GEOCAST_TRACE);
+    GeocastActionTracer::Destroy();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnGeocastActionTracer, GeocastActionTracerFixture)
+
+BOOST_AUTO_TEST_CASE(BinaryToCsv)
+{
+  GeocastActionTracer::InstallAll(TEST_GEOCAST_TRACE.string());
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  GeocastActionTracer::Destroy(); // to force trace to be written
+
+  // consumer's Interest is received and forwarded by both nodes
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(TEST_GEOCAST_TRACE),
+                    12 + 4 * sizeof(GeocastActionTracer::Record));
+
+  std::ostringstream os;
+  BOOST_CHECK_EQUAL(GeocastActionTracer::ConvertToCsv(TEST_GEOCAST_TRACE.string(), os), 4);
+
+  std::string node1 = std::to_string(getNode("1")->GetId());
+  BOOST_CHECK_EQUAL(os.str().substr(0, os.str().find('\n', os.str().find('\n') + 1) + 1),
+                    "Node,Time,Name,Action,X,Y\n" +
+                    node1 + ",0,0,Received,0,0\n");
+}
+
+BOOST_AUTO_TEST_CASE(NotATrace)
+{
+  std::ofstream(TEST_GEOCAST_TRACE.string()) << "Node,Time,Name,Action,X,Y\n";
+
+  std::ostringstream os;
+  BOOST_CHECK_THROW(GeocastActionTracer::ConvertToCsv(TEST_GEOCAST_TRACE.string(), os),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
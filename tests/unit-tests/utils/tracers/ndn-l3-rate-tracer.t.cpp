@@ -18,9 +18,14 @@
  **/
 
 #include "utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "helper/ndn-network-region-table-helper.hpp"
+#include "model/ndn-net-device-transport.hpp"
+
+#include "ns3/drop-tail-queue.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
+#include <boost/algorithm/string.hpp>
 
 #include "../../tests-common.hpp"
 
@@ -121,5 +126,141 @@ BOOST_AUTO_TEST_CASE(NackTracing)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+class L3RateTracerAggregatedFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  L3RateTracerAggregatedFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.95s"}, // 10 Interests, all satisfied before 1s
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~L3RateTracerAggregatedFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    L3RateTracer::Destroy();
+    L3RateTracer::SetTxQueueTracing(false);
+  }
+
+  /**
+   * @brief Run until 1.5s and get {Node, Type, PacketRaw} of lines written at 1s
+   */
+  std::vector<std::vector<std::string>>
+  run(L3RateTracer::Granularity granularity)
+  {
+    L3RateTracer::InstallAggregated(TEST_TRACE.string(), granularity, Seconds(1));
+
+    Simulator::Stop(Seconds(1.5));
+    Simulator::Run();
+
+    L3RateTracer::Destroy(); // to force log to be written
+
+    std::ifstream is(TEST_TRACE.string().c_str());
+    std::string line;
+    std::getline(is, line);
+    BOOST_CHECK_EQUAL(line, "Time	Node	FaceId	FaceDescr	Type	Packets	Kilobytes	PacketRaw	"
+                            "KilobytesRaw");
+
+    std::vector<std::vector<std::string>> lines;
+    while (std::getline(is, line)) {
+      std::vector<std::string> fields;
+      boost::split(fields, line, boost::is_any_of("\t"));
+      BOOST_REQUIRE_EQUAL(fields.size(), 9);
+      BOOST_CHECK_EQUAL(fields[0], "1");
+      BOOST_CHECK_EQUAL(fields[2], "-1");
+      lines.push_back({fields[1], fields[4], fields[7]});
+    }
+    return lines;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnL3RateTracerAggregated, L3RateTracerAggregatedFixture)
+
+BOOST_AUTO_TEST_CASE(Node)
+{
+  auto lines = run(L3RateTracer::Granularity::NODE);
+  BOOST_REQUIRE_EQUAL(lines.size(), 2);
+  BOOST_CHECK((lines[0] == std::vector<std::string>{"1", "InData", "10"}));
+  BOOST_CHECK((lines[1] == std::vector<std::string>{"2", "InData", "10"}));
+}
+
+BOOST_AUTO_TEST_CASE(Region)
+{
+  NetworkRegionTableHelper::AddRegionName(getNode("1"), Name("/ucla"));
+
+  auto lines = run(L3RateTracer::Granularity::REGION);
+  BOOST_REQUIRE_EQUAL(lines.size(), 2);
+  BOOST_CHECK((lines[0] == std::vector<std::string>{"/ucla", "InData", "10"}));
+  BOOST_CHECK((lines[1] == std::vector<std::string>{"none", "InData", "10"}));
+}
+
+BOOST_AUTO_TEST_CASE(Network)
+{
+  auto lines = run(L3RateTracer::Granularity::NETWORK);
+  BOOST_REQUIRE_EQUAL(lines.size(), 1);
+  BOOST_CHECK((lines[0] == std::vector<std::string>{"all", "InData", "20"}));
+}
+
+BOOST_AUTO_TEST_CASE(TxQueue)
+{
+  auto face = getFace("2", "1");
+  auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
+  auto device = DynamicCast<PointToPointNetDevice>(transport->GetNetDevice());
+  BOOST_CHECK(transport->GetTxQueue() == device->GetQueue());
+
+  // replaced queue of PointToPointNetDevice is picked up without explicit refresh
+  auto queue = CreateObject<DropTailQueue<ns3::Packet>>();
+  device->SetQueue(queue);
+  BOOST_CHECK(transport->GetTxQueue() == queue);
+
+  L3RateTracer::SetTxQueueTracing(true);
+  L3RateTracer::Install(getNode("2"), TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_TRACE.string().c_str());
+  std::string line;
+  std::vector<std::vector<std::string>> lines;
+  while (std::getline(is, line)) {
+    std::vector<std::string> fields;
+    boost::split(fields, line, boost::is_any_of("\t"));
+    BOOST_REQUIRE_EQUAL(fields.size(), 9);
+    if (fields[4] == "TxQueue") {
+      lines.push_back({fields[2], fields[5], fields[7]});
+    }
+  }
+
+  // all Data packets left the queue before 1s
+  BOOST_REQUIRE_EQUAL(lines.size(), 1);
+  BOOST_CHECK_EQUAL(lines[0][0], std::to_string(face->getId()));
+  BOOST_CHECK_EQUAL(lines[0][1], "0");
+  BOOST_CHECK_EQUAL(lines[0][2], "0");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 } // namespace ndn
 } // namespace ns3
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-sink.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
+const boost::filesystem::path TEST_GZIP_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin.gz";
+
+struct TestRecord
+{
+  int64_t value;
+  uint32_t name;
+  uint32_t index;
+};
+
+class TraceSinkFixture
+{
+public:
+  TraceSinkFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TraceSinkFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_GZIP_TRACE);
+  }
+
+  /**
+   * @brief Write @p nRecords (several blocks) and check that they are read back in order
+   */
+  void
+  writeAndRead(const boost::filesystem::path& file, uint32_t nRecords)
+  {
+    {
+      auto sink = TraceSink::Open(file.string(), TraceSink::L3_RATE);
+      BOOST_REQUIRE(sink != nullptr);
+      for (uint32_t i = 0; i < nRecords; ++i) {
+        TestRecord record = {-static_cast<int64_t>(i), sink->GetStringId(std::to_string(i % 10)),
+                             i};
+        sink->Append(1 + i % 2, record);
+      }
+    }
+
+    TraceReader reader(file.string());
+    BOOST_CHECK_EQUAL(reader.GetFormat(), TraceSink::L3_RATE);
+
+    uint32_t nRead = 0;
+    TraceReader::Entry entry;
+    while (reader.Next(entry)) {
+      BOOST_REQUIRE_EQUAL(entry.type, 1 + nRead % 2);
+      auto record = entry.as<TestRecord>();
+      BOOST_REQUIRE_EQUAL(record.index, nRead);
+      BOOST_REQUIRE_EQUAL(record.value, -static_cast<int64_t>(nRead));
+      BOOST_REQUIRE_EQUAL(reader.GetString(record.name), std::to_string(nRead % 10));
+      ++nRead;
+    }
+    BOOST_CHECK_EQUAL(nRead, nRecords);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceSink, TraceSinkFixture)
+
+BOOST_AUTO_TEST_CASE(IsBinaryFile)
+{
+  BOOST_CHECK(TraceSink::IsBinaryFile("trace.bin"));
+  BOOST_CHECK(TraceSink::IsBinaryFile("results/trace.bin.gz"));
+  BOOST_CHECK(!TraceSink::IsBinaryFile("trace.txt"));
+  BOOST_CHECK(!TraceSink::IsBinaryFile("trace.bin.txt"));
+  BOOST_CHECK(!TraceSink::IsBinaryFile("-"));
+}
+
+BOOST_AUTO_TEST_CASE(Uncompressed)
+{
+  writeAndRead(TEST_TRACE, 100000);
+}
+
+BOOST_AUTO_TEST_CASE(Gzip)
+{
+  writeAndRead(TEST_GZIP_TRACE, 100000);
+}
+
+BOOST_AUTO_TEST_CASE(TimeResolution)
+{
+  {
+    auto sink = TraceSink::Open(TEST_TRACE.string(), TraceSink::APP_DELAY);
+    sink->Append(1, TestRecord{Seconds(1.5).GetTimeStep(), 0, 0});
+  }
+  TraceReader reader(TEST_TRACE.string());
+  BOOST_CHECK_EQUAL(reader.GetResolution(), Time::GetResolution());
+
+  TraceReader::Entry entry;
+  BOOST_REQUIRE(reader.Next(entry));
+  BOOST_CHECK_EQUAL(reader.GetTime(entry.as<TestRecord>().value), Seconds(1.5));
+
+  // trace written by a simulation with microsecond resolution
+  {
+    std::ofstream os(TEST_TRACE.string().c_str(), std::ios_base::binary);
+    uint32_t header[3] = {TraceSink::APP_DELAY, TraceSink::NONE, Time::US};
+    os.write("NDNTRCE2", 8);
+    os.write(reinterpret_cast<const char*>(header), sizeof(header));
+  }
+  BOOST_CHECK_EQUAL(TraceReader(TEST_TRACE.string()).GetResolution(), Time::US);
+  BOOST_CHECK_EQUAL(TraceReader(TEST_TRACE.string()).GetTime(1500000), Seconds(1.5));
+
+  // older traces without resolution use the default one
+  {
+    std::ofstream os(TEST_TRACE.string().c_str(), std::ios_base::binary);
+    uint32_t header[2] = {TraceSink::APP_DELAY, TraceSink::NONE};
+    os.write("NDNTRCE1", 8);
+    os.write(reinterpret_cast<const char*>(header), sizeof(header));
+  }
+  BOOST_CHECK_EQUAL(TraceReader(TEST_TRACE.string()).GetResolution(), Time::NS);
+  BOOST_CHECK_EQUAL(TraceReader(TEST_TRACE.string()).GetTime(1500000000), Seconds(1.5));
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  {
+    std::ofstream os(TEST_TRACE.string().c_str());
+    os << "Time\tNode\n";
+  }
+  BOOST_CHECK_THROW(TraceReader(TEST_TRACE.string()), std::runtime_error);
+  BOOST_CHECK_THROW(TraceReader((TEST_CONFIG_PATH "/nonexistent.bin")), std::runtime_error);
+
+  // truncated entry
+  {
+    auto sink = TraceSink::Open(TEST_TRACE.string(), TraceSink::CS);
+    sink->Append(1, TestRecord{1, 0, 0});
+  }
+  boost::filesystem::resize_file(TEST_TRACE, boost::filesystem::file_size(TEST_TRACE) - 1);
+
+  TraceReader reader(TEST_TRACE.string());
+  TraceReader::Entry entry;
+  BOOST_CHECK_THROW(reader.Next(entry), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-alias-table.hpp"
+
+#include "ns3/assert.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ns3 {
+namespace ndn {
+
+AliasTable::AliasTable(std::vector<double> weights)
+  : m_probability(std::move(weights))
+  , m_alias(m_probability.size())
+{
+  const size_t n = m_probability.size();
+  if (n == 0 || n > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("Invalid number of weights");
+  }
+
+  double sum = 0;
+  for (double weight : m_probability) {
+    if (!(weight >= 0)) {
+      throw std::invalid_argument("Weights must be non-negative");
+    }
+    sum += weight;
+  }
+  if (!(sum > 0)) {
+    throw std::invalid_argument("All weights are zero");
+  }
+
+  // scale weights so that their average is 1 (vectorizable)
+  const double scale = n / sum;
+  double* scaled = m_probability.data();
+  for (size_t i = 0; i < n; ++i) {
+    scaled[i] *= scale;
+  }
+
+  // Vose's method: columns below 1 ("small") are filled up from columns above 1 ("large").
+  // Both worklists share one buffer: small from the front, large from the back.
+  std::vector<uint32_t> worklist(n);
+  size_t nSmall = 0;
+  size_t largeBegin = n;
+  for (size_t i = 0; i < n; ++i) {
+    if (scaled[i] < 1.0) {
+      worklist[nSmall++] = static_cast<uint32_t>(i);
+    }
+    else {
+      worklist[--largeBegin] = static_cast<uint32_t>(i);
+    }
+  }
+
+  while (nSmall > 0 && largeBegin < n) {
+    uint32_t small = worklist[--nSmall];
+    uint32_t large = worklist[largeBegin];
+
+    m_alias[small] = large;
+    scaled[large] = (scaled[large] + scaled[small]) - 1.0;
+    if (scaled[large] < 1.0) {
+      ++largeBegin;
+      worklist[nSmall++] = large;
+    }
+  }
+
+  // remaining columns are full (only differ from 1 by rounding errors)
+  while (largeBegin < n) {
+    uint32_t large = worklist[largeBegin++];
+    scaled[large] = 1.0;
+    m_alias[large] = large;
+  }
+  while (nSmall > 0) {
+    uint32_t small = worklist[--nSmall];
+    scaled[small] = 1.0;
+    m_alias[small] = small;
+  }
+}
+
+std::vector<double>
+AliasTable::makeZipfMandelbrotWeights(uint32_t n, double q, double s)
+{
+  std::vector<double> weights(n);
+  double* w = weights.data();
+  for (uint32_t i = 0; i < n; ++i) {
+    w[i] = std::exp(-s * std::log(i + 1 + q));
+  }
+  return weights;
+}
+
+double
+AliasTable::getProbability(size_t index) const
+{
+  const size_t n = m_alias.size();
+  NS_ASSERT(index < n);
+
+  double columns = m_probability[index];
+  for (size_t i = 0; i < n; ++i) {
+    if (m_alias[i] == index && i != index) {
+      columns += 1.0 - m_probability[i];
+    }
+  }
+  return columns / n;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_ALIAS_TABLE_HPP
+#define NDNSIM_UTILS_NDN_ALIAS_TABLE_HPP
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Immutable Walker/Vose alias table for O(1) sampling from a discrete distribution
+ *
+ * The table is built in O(N) time.  Each sample takes a single uniform random number:
+ * its integer part (scaled by N) selects a column and its fractional part chooses between the
+ * column and its alias.  The table is not modified after construction, so it can be shared
+ * by any number of users.
+ */
+class AliasTable : boost::noncopyable {
+public:
+  /**
+   * @brief Build table for the distribution proportional to @p weights
+   *
+   * @param weights non-negative weights, not all zero; the vector is reused as table storage
+   * @throw std::invalid_argument if @p weights is empty, too large, has a negative weight,
+   *        or sums to zero
+   */
+  explicit
+  AliasTable(std::vector<double> weights);
+
+  /**
+   * @brief Get weights of Zipf-Mandelbrot distribution, P(k) ~ 1 / (k + q)^s for k in [1, n]
+   *
+   * Weight i corresponds to rank k = i + 1.
+   */
+  static std::vector<double>
+  makeZipfMandelbrotWeights(uint32_t n, double q, double s);
+
+  size_t
+  size() const
+  {
+    return m_alias.size();
+  }
+
+  /**
+   * @brief Get the sample corresponding to the uniform random number @p u in [0, 1)
+   * @return index in [0, size())
+   */
+  size_t
+  sample(double u) const
+  {
+    double x = u * m_alias.size();
+    size_t column = static_cast<size_t>(x);
+    if (column >= m_alias.size()) { // u == 1 or rounding
+      column = m_alias.size() - 1;
+    }
+    return (x - column) < m_probability[column] ? column : m_alias[column];
+  }
+
+  /**
+   * @brief Get probability of the sample, as represented by the table
+   * @note This is O(N) and intended for diagnostics and tests
+   */
+  double
+  getProbability(size_t index) const;
+
+private:
+  std::vector<double> m_probability; ///< probability to keep column instead of its alias
+  std::vector<uint32_t> m_alias;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_ALIAS_TABLE_HPP
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-event-trace.hpp"
+
+#include "ns3/simulator.h"
+
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+EventTrace&
+EventTrace::get()
+{
+  static EventTrace instance;
+  return instance;
+}
+
+bool
+EventTrace::isEnabled()
+{
+#ifdef NDNSIM_EVENT_TRACE
+  return true;
+#else
+  return false;
+#endif // NDNSIM_EVENT_TRACE
+}
+
+uint64_t&
+EventTrace::getCounter(const std::string& component, const std::string& name)
+{
+  return m_counters[std::make_pair(component, name)];
+}
+
+uint64_t
+EventTrace::getCount(const std::string& component, const std::string& name) const
+{
+  auto it = m_counters.find(std::make_pair(component, name));
+  return it != m_counters.end() ? it->second : 0;
+}
+
+void
+EventTrace::emitToSink(const char* component, const char* name, uint64_t value, int64_t detail)
+{
+  m_sink(Event{Simulator::Now(), Simulator::GetContext(), component, name, value, detail});
+}
+
+EventTrace::Sink
+EventTrace::makeTextSink(std::ostream& os)
+{
+  return [&os] (const Event& event) {
+    os << event.time.ToDouble(Time::S) << "\t" << event.context << "\t" << event.component
+       << "\t" << event.name << "\t" << event.value << "\t" << event.detail << "\n";
+  };
+}
+
+void
+EventTrace::printCounters(std::ostream& os) const
+{
+  os << "Component\tEvent\tCount\n";
+  for (const auto& counter : m_counters) {
+    os << counter.first.first << "\t" << counter.first.second << "\t" << counter.second << "\n";
+  }
+}
+
+void
+EventTrace::reset()
+{
+  // counters are referenced from call sites, so they are only zeroed
+  for (auto& counter : m_counters) {
+    counter.second = 0;
+  }
+  m_sink = nullptr;
+}
+
+} // namespace ndn
+} // namespace ns3
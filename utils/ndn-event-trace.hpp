@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_EVENT_TRACE_HPP
+#define NDNSIM_UTILS_NDN_EVENT_TRACE_HPP
+
+#include "ns3/nstime.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Per-packet event counters and an optional event sink
+ *
+ * Hot paths of applications and strategies report events with NDNSIM_TRACE_EVENT.  The macro
+ * compiles to nothing unless ndnSIM is configured with `--enable-ndnsim-event-trace`; when
+ * enabled, every event increments its counter, and is passed to the sink if one is set.
+ *
+ * Example of restoring a textual log of all events:
+ *
+ *     ndn::EventTrace::get().setSink(ndn::EventTrace::makeTextSink(std::cout));
+ */
+class EventTrace : boost::noncopyable {
+public:
+  struct Event {
+    Time time;
+    uint32_t context;      ///< ns-3 context (node ID) of the event
+    const char* component;
+    const char* name;
+    uint64_t value;        ///< event-specific value, e.g., sequence number
+    int64_t detail;        ///< event-specific detail, e.g., hop count
+  };
+
+  typedef std::function<void(const Event&)> Sink;
+
+  static EventTrace&
+  get();
+
+  /**
+   * @brief Check whether NDNSIM_TRACE_EVENT is compiled in
+   */
+  static bool
+  isEnabled();
+
+  /**
+   * @brief Get counter of the event, creating it if needed
+   * @return reference that stays valid for the whole program run
+   */
+  uint64_t&
+  getCounter(const std::string& component, const std::string& name);
+
+  /**
+   * @brief Get current value of the counter, or 0 if the event was never registered
+   */
+  uint64_t
+  getCount(const std::string& component, const std::string& name) const;
+
+  /**
+   * @brief Pass the event to the sink, if any
+   */
+  void
+  emit(const char* component, const char* name, uint64_t value, int64_t detail)
+  {
+    if (m_sink) {
+      emitToSink(component, name, value, detail);
+    }
+  }
+
+  void
+  setSink(Sink sink)
+  {
+    m_sink = std::move(sink);
+  }
+
+  /**
+   * @brief Make sink writing one tab-separated line per event:
+   *        Time, Context, Component, Event, Value, Detail
+   */
+  static Sink
+  makeTextSink(std::ostream& os);
+
+  /**
+   * @brief Print all counters, one "Component<TAB>Event<TAB>Count" line each
+   */
+  void
+  printCounters(std::ostream& os) const;
+
+  /**
+   * @brief Reset all counters to zero and remove the sink
+   */
+  void
+  reset();
+
+private:
+  EventTrace() = default;
+
+  void
+  emitToSink(const char* component, const char* name, uint64_t value, int64_t detail);
+
+private:
+  std::map<std::pair<std::string, std::string>, uint64_t> m_counters;
+  Sink m_sink;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#ifdef NDNSIM_EVENT_TRACE
+/**
+ * @brief Count event and pass it to the EventTrace sink
+ *
+ * The counter is looked up only once per call site.
+ */
+#define NDNSIM_TRACE_EVENT(component, name, value, detail)                                        \
+  do {                                                                                             \
+    static uint64_t& ndnsimEventCounter =                                                          \
+      ::ns3::ndn::EventTrace::get().getCounter(component, name);                                  \
+    ++ndnsimEventCounter;                                                                          \
+    ::ns3::ndn::EventTrace::get().emit(component, name, value, detail);                           \
+  } while (false)
+#else
+#define NDNSIM_TRACE_EVENT(component, name, value, detail) do {} while (false)
+#endif // NDNSIM_EVENT_TRACE
+
+#endif // NDNSIM_UTILS_NDN_EVENT_TRACE_HPP
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-ns2-trace-line.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t MAX_TOKENS = 9;
+
+namespace {
+
+struct Token
+{
+  const char* begin;
+  const char* end;
+
+  bool
+  operator==(const char* str) const
+  {
+    size_t len = std::strlen(str);
+    return static_cast<size_t>(end - begin) == len && std::equal(begin, end, str);
+  }
+};
+
+} // namespace
+
+/**
+ * @brief Split line into at most MAX_TOKENS tokens, ignoring comments, quotes and ';'
+ * @return number of tokens, or MAX_TOKENS + 1 if the line has more tokens
+ */
+static size_t
+tokenize(const char* pos, const char* end, Token* tokens)
+{
+  auto isDelimiter = [] (char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '"' || c == ';';
+  };
+
+  size_t nTokens = 0;
+  while (pos != end && *pos != '#') {
+    if (isDelimiter(*pos)) {
+      ++pos;
+      continue;
+    }
+    if (nTokens == MAX_TOKENS) {
+      return MAX_TOKENS + 1;
+    }
+
+    Token& token = tokens[nTokens++];
+    token.begin = pos;
+    while (pos != end && !isDelimiter(*pos) && *pos != '#') {
+      ++pos;
+    }
+    token.end = pos;
+  }
+  return nTokens;
+}
+
+static double
+parseNumber(const Token& token)
+{
+  double value = 0;
+#if defined(__cpp_lib_to_chars)
+  auto result = std::from_chars(token.begin, token.end, value);
+  if (token.begin != token.end && result.ec == std::errc() && result.ptr == token.end) {
+    return value;
+  }
+#else
+  // the line may not be null-terminated (e.g., memory-mapped file)
+  char buffer[64];
+  size_t len = token.end - token.begin;
+  if (len > 0 && len < sizeof(buffer)) {
+    std::memcpy(buffer, token.begin, len);
+    buffer[len] = '\0';
+
+    char* parsed = nullptr;
+    value = std::strtod(buffer, &parsed);
+    if (parsed == buffer + len) {
+      return value;
+    }
+  }
+#endif
+  throw std::invalid_argument("Invalid number '" + std::string(token.begin, token.end) + "'");
+}
+
+/**
+ * @brief Get node id from the token like $node_(4)
+ */
+static uint32_t
+parseNodeId(const Token& token)
+{
+  const char* open = std::find(token.begin, token.end, '(');
+  if (open == token.end || *(token.end - 1) != ')' || open + 1 >= token.end - 1) {
+    throw std::invalid_argument("Invalid node '" + std::string(token.begin, token.end) + "'");
+  }
+
+  uint64_t value = 0;
+  for (const char* i = open + 1; i != token.end - 1; ++i) {
+    if (*i < '0' || *i > '9') {
+      throw std::invalid_argument("Invalid node '" + std::string(token.begin, token.end) + "'");
+    }
+    value = value * 10 + (*i - '0');
+    if (value >= std::numeric_limits<uint32_t>::max()) {
+      throw std::invalid_argument("Node id is too large");
+    }
+  }
+  return static_cast<uint32_t>(value);
+}
+
+Ns2TraceLine
+Ns2TraceLine::Parse(const char* begin, const char* end)
+{
+  Ns2TraceLine line;
+
+  Token tokens[MAX_TOKENS];
+  size_t nTokens = tokenize(begin, end, tokens);
+  if (nTokens == 0) {
+    return line;
+  }
+
+  // $ns_ at 4 "...": the command follows the time
+  const Token* command = tokens;
+  size_t nCommandTokens = nTokens;
+  if (nTokens >= 3 && tokens[0] == "$ns_" && tokens[1] == "at") {
+    line.isScheduled = true;
+    line.time = parseNumber(tokens[2]);
+    command += 3;
+    nCommandTokens -= 3;
+  }
+
+  if (nCommandTokens == 4 && command[1] == "set") {
+    // $node_(0) set X_ 11
+    line.type = SET;
+    line.node = parseNodeId(command[0]);
+    if (command[2] == "X_") {
+      line.coordinate = 0;
+    }
+    else if (command[2] == "Y_") {
+      line.coordinate = 1;
+    }
+    else if (command[2] == "Z_") {
+      line.coordinate = 2;
+    }
+    else {
+      throw std::invalid_argument("Unknown variable '" +
+                                  std::string(command[2].begin, command[2].end) + "'");
+    }
+    line.value = parseNumber(command[3]);
+  }
+  else if (line.isScheduled && nCommandTokens == 6 && command[1] == "setdest") {
+    // $ns_ at 1 "$node_(0) setdest 2 3 4 90"
+    line.type = SETDEST;
+    line.node = parseNodeId(command[0]);
+    line.position = Vector(parseNumber(command[2]), parseNumber(command[3]), 0);
+
+    double speed = parseNumber(command[4]);
+    double angle = parseNumber(command[5]) * M_PI / 180;
+    line.velocity = Vector(speed * std::cos(angle), speed * std::sin(angle), 0);
+  }
+  else {
+    throw std::invalid_argument("Line is not recognized");
+  }
+
+  return line;
+}
+
+} // namespace ndn
+} // namespace ns3
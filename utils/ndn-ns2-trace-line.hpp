@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_NS2_TRACE_LINE_HPP
+#define NDNSIM_UTILS_NDN_NS2_TRACE_LINE_HPP
+
+#include "ns3/vector.h"
+
+#include <cstdint>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Parsed line of ns-2 movement trace, as exported from SUMO
+ *
+ * Recognized lines are:
+ *
+ *     $node_(id) set X_ value                    # initial coordinate: X_, Y_, or Z_
+ *     $ns_ at time "$node_(id) set X_ value"     # coordinate set at the given time
+ *     $ns_ at time "$node_(id) setdest x y speed angle"
+ *
+ * `setdest` gives position, speed, and heading (in degrees) of the node at the given time.
+ *
+ * This is the parser shared by CustomHelper and WaypointTable::LoadNs2.  It works in place on
+ * the line characters (e.g., of a memory-mapped file) without allocations.
+ */
+struct Ns2TraceLine
+{
+  enum Type {
+    EMPTY,   ///< empty line or comment
+    SET,     ///< set one coordinate of the position
+    SETDEST, ///< set position and velocity
+  };
+
+  /**
+   * @brief Parse line [@p begin, @p end), excluding the line terminator
+   * @throw std::invalid_argument the line is malformed or not recognized
+   */
+  static Ns2TraceLine
+  Parse(const char* begin, const char* end);
+
+  Type type = EMPTY;
+  uint32_t node = 0;
+  bool isScheduled = false; ///< whether the line starts with `$ns_ at time`
+  double time = 0;          ///< time of a scheduled line, in seconds
+  int coordinate = 0;       ///< SET: 0 for X_, 1 for Y_, 2 for Z_
+  double value = 0;         ///< SET: value of the coordinate
+  Vector position;          ///< SETDEST: position of the node (z is 0)
+  Vector velocity;          ///< SETDEST: velocity of the node
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_NS2_TRACE_LINE_HPP
@@ -69,6 +69,7 @@ RttMeanDeviation::RttMeanDeviation(const RttMeanDeviation& c)
   , m_gain(c.m_gain)
   , m_gain2(c.m_gain2)
   , m_variance(c.m_variance)
+  , m_sent(c.m_sent)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -130,6 +131,7 @@ RttMeanDeviation::Reset()
   NS_LOG_FUNCTION(this);
   // Reset to initial state
   m_variance = Seconds(0);
+  m_sent = SeqWindow<SentRecord>();
   RttEstimator::Reset();
 }
 
@@ -147,17 +149,14 @@ RttMeanDeviation::SentSeq(SequenceNumber32 seq, uint32_t size)
 {
   NS_LOG_FUNCTION(this << seq << size);
 
-  RttHistory_t::iterator i;
-  for (i = m_history.begin(); i != m_history.end(); ++i) {
-    if (seq == i->seq) { // Found it
-      i->retx = true;
-      break;
-    }
+  SentRecord* record = m_sent.find(seq.GetValue());
+  if (record != nullptr) { // This is a retransmit, mark as re-tx
+    record->retx = true;
+    return;
   }
 
   // Note that a particular sequence has been sent
-  if (i == m_history.end())
-    m_history.push_back(RttHistory(seq, size, Simulator::Now()));
+  m_sent.insert(seq.GetValue()).time = Simulator::Now();
 }
 
 Time
@@ -165,26 +164,28 @@ RttMeanDeviation::AckSeq(SequenceNumber32 ackSeq)
 {
   NS_LOG_FUNCTION(this << ackSeq);
   // An ack has been received, calculate rtt and log this measurement
-  // Note we use a linear search (O(n)) for this since for the common
-  // case the ack'ed packet will be at the head of the list
   Time m = Seconds(0.0);
-  if (m_history.size() == 0)
+  SentRecord* record = m_sent.find(ackSeq.GetValue());
+  if (record == nullptr)
     return (m); // No pending history, just exit
 
-  for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i) {
-    if (ackSeq == i->seq) { // Found it
-      if (!i->retx) {
-        m = Simulator::Now() - i->time; // Elapsed time
-        Measurement(m);                 // Log the measurement
-        ResetMultiplier();              // Reset multiplier on valid measurement
-      }
-      m_history.erase(i);
-      break;
-    }
+  if (!record->retx) { // Karn's rule: no samples from retransmitted sequences
+    m = Simulator::Now() - record->time; // Elapsed time
+    Measurement(m);                      // Log the measurement
+    ResetMultiplier();                   // Reset multiplier on valid measurement
   }
+  m_sent.erase(ackSeq.GetValue());
 
   return m;
 }
 
+void
+RttMeanDeviation::ClearSent()
+{
+  NS_LOG_FUNCTION(this);
+  m_sent = SeqWindow<SentRecord>();
+  RttEstimator::ClearSent();
+}
+
 } // namespace ndn
 } // namespace ns3
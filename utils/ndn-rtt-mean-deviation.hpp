@@ -29,6 +29,7 @@
 #define NDN_RTT_MEAN_DEVIATION_H
 
 #include "ndn-rtt-estimator.hpp"
+#include "ndn-seq-window.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -43,6 +44,10 @@ namespace ndn {
  * by Van Jacobson and Michael J. Karels, in
  * "Congestion Avoidance and Control", SIGCOMM 88, Appendix A
  *
+ * Outstanding sequence numbers are kept in a SeqWindow rather than in the base class history
+ * list, so that sends and out-of-order acknowledgements take constant time regardless of the
+ * number of outstanding Interests.  Following Karn's rule, acknowledgements of retransmitted
+ * sequence numbers are not used as RTT samples.
  */
 class RttMeanDeviation : public RttEstimator {
 public:
@@ -60,6 +65,8 @@ public:
   Time
   AckSeq(SequenceNumber32 ackSeq);
   void
+  ClearSent();
+  void
   Measurement(Time measure);
   Time
   RetransmitTimeout();
@@ -71,9 +78,15 @@ public:
   Gain(double g);
 
 private:
+  struct SentRecord {
+    Time time;         // Time this one was sent
+    bool retx = false; // True if this has been retransmitted
+  };
+
   double m_gain;   // Filter gain
   double m_gain2;  // Filter gain
   Time m_variance; // Current variance
+  SeqWindow<SentRecord> m_sent; // Outstanding sequence numbers
 };
 
 } // namespace ndn
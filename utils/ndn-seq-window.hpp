@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_SEQ_WINDOW_HPP
+#define NDNSIM_UTILS_NDN_SEQ_WINDOW_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Map from sequence number to a record, stored as a ring buffer over the window of
+ *        sequence numbers currently in use
+ *
+ * A record for sequence number @p seq lives in slot `seq mod capacity`, where the capacity is
+ * a power of two not smaller than the distance between the lowest and the highest stored
+ * sequence numbers.  When requests are mostly sequential, lookup, insertion and removal are O(1)
+ * and no memory is allocated once the ring has grown to the size of the in-flight window.
+ *
+ * Sequence numbers that would stretch the window beyond @p maxSpan (e.g., random content ranks)
+ * are kept in a hash table instead.
+ *
+ * @tparam T default-constructible record type
+ */
+template<typename T>
+class SeqWindow {
+public:
+  explicit
+  SeqWindow(size_t maxSpan = 65536)
+    : m_maxSpan(maxSpan)
+    , m_base(0)
+    , m_end(0)
+    , m_nInRing(0)
+  {
+  }
+
+  /**
+   * @brief Get record of @p seq
+   * @return pointer to the record or nullptr if there is none; the pointer is valid until the
+   *         next insert
+   */
+  T*
+  find(uint32_t seq)
+  {
+    if (isInWindow(seq)) {
+      Slot& slot = m_ring[seq & (m_ring.size() - 1)];
+      if (slot.isUsed) {
+        return &slot.value;
+      }
+    }
+    if (m_overflow.empty()) {
+      return nullptr;
+    }
+    auto it = m_overflow.find(seq);
+    return it != m_overflow.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * @brief Get record of @p seq, creating a default one if there is none
+   */
+  T&
+  insert(uint32_t seq)
+  {
+    T* existing = find(seq);
+    if (existing != nullptr) {
+      return *existing;
+    }
+
+    uint64_t base = m_base;
+    uint64_t end = m_end;
+    if (m_nInRing == 0) {
+      base = seq;
+      end = uint64_t(seq) + 1;
+    }
+    else if (!isInWindow(seq)) {
+      base = std::min<uint64_t>(base, seq);
+      end = std::max<uint64_t>(end, uint64_t(seq) + 1);
+      if (end - base > m_maxSpan) {
+        return m_overflow[seq];
+      }
+    }
+
+    if (end - base > m_ring.size()) {
+      grow(end - base);
+    }
+    m_base = base;
+    m_end = end;
+
+    Slot& slot = m_ring[seq & (m_ring.size() - 1)];
+    slot.isUsed = true;
+    ++m_nInRing;
+    return slot.value;
+  }
+
+  /**
+   * @brief Remove record of @p seq, if any
+   */
+  void
+  erase(uint32_t seq)
+  {
+    if (isInWindow(seq)) {
+      Slot& slot = m_ring[seq & (m_ring.size() - 1)];
+      if (slot.isUsed) {
+        slot.value = T();
+        slot.isUsed = false;
+        --m_nInRing;
+        shrink();
+        return;
+      }
+    }
+    if (!m_overflow.empty()) {
+      m_overflow.erase(seq);
+    }
+  }
+
+  size_t
+  size() const
+  {
+    return m_nInRing + m_overflow.size();
+  }
+
+  bool
+  empty() const
+  {
+    return size() == 0;
+  }
+
+private:
+  bool
+  isInWindow(uint32_t seq) const
+  {
+    return m_nInRing > 0 && seq >= m_base && seq < m_end;
+  }
+
+  void
+  grow(uint64_t span)
+  {
+    size_t capacity = m_ring.empty() ? 16 : m_ring.size();
+    while (capacity < span) {
+      capacity *= 2;
+    }
+
+    std::vector<Slot> ring(capacity);
+    if (m_nInRing > 0) {
+      // the current window fits the old ring, so every slot in it belongs to a unique seq
+      for (uint64_t seq = m_base; seq < m_end; ++seq) {
+        Slot& slot = m_ring[seq & (m_ring.size() - 1)];
+        if (slot.isUsed) {
+          ring[seq & (capacity - 1)] = std::move(slot);
+        }
+      }
+    }
+    m_ring.swap(ring);
+  }
+
+  /**
+   * @brief Move window boundaries to the lowest and the highest stored sequence numbers
+   */
+  void
+  shrink()
+  {
+    if (m_nInRing == 0) {
+      m_end = m_base;
+      return;
+    }
+    while (!m_ring[m_base & (m_ring.size() - 1)].isUsed) {
+      ++m_base;
+    }
+    while (!m_ring[(m_end - 1) & (m_ring.size() - 1)].isUsed) {
+      --m_end;
+    }
+  }
+
+private:
+  struct Slot {
+    T value;
+    bool isUsed = false;
+  };
+
+  size_t m_maxSpan;
+  std::vector<Slot> m_ring;
+  uint64_t m_base; ///< lowest sequence number in the ring
+  uint64_t m_end;  ///< one past the highest sequence number in the ring
+  size_t m_nInRing;
+  std::unordered_map<uint32_t, T> m_overflow;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_SEQ_WINDOW_HPP
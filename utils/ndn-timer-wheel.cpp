@@ -0,0 +1,343 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-timer-wheel.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+static const uint64_t NO_WAKEUP = std::numeric_limits<uint64_t>::max();
+
+TimerWheel::TimerWheel(Time resolution)
+  : m_resolution(resolution)
+  , m_freeList(INVALID_INDEX)
+  , m_nPending(0)
+  , m_firingHead(INVALID_INDEX)
+  , m_currentTick(0)
+  , m_wakeupTick(NO_WAKEUP)
+  , m_isExpiring(false)
+{
+  NS_ASSERT_MSG(m_resolution.IsStrictlyPositive(), "TimerWheel resolution must be positive");
+
+  std::fill(std::begin(m_heads), std::end(m_heads), INVALID_INDEX);
+  std::fill(std::begin(m_nInLevel), std::end(m_nInLevel), 0);
+  std::fill(std::begin(m_bitmap), std::end(m_bitmap), 0);
+}
+
+TimerWheel::~TimerWheel()
+{
+  if (m_wakeupEvent.IsRunning()) {
+    Simulator::Remove(m_wakeupEvent);
+  }
+}
+
+TimerWheel::TimerId
+TimerWheel::schedule(Time delay, Callback callback)
+{
+  NS_ASSERT(!delay.IsStrictlyNegative());
+
+  if (m_nPending == 0) {
+    // nothing to process, idle wheel can simply jump to the current time
+    m_currentTick = std::max(m_currentTick, getCurrentTick());
+  }
+
+  uint64_t resolution = m_resolution.GetTimeStep();
+  uint64_t expiry = (Simulator::Now() + delay).GetTimeStep();
+  expiry = (expiry + resolution - 1) / resolution; // round up
+  expiry = std::max(expiry, m_currentTick + 1);
+
+  uint32_t index = allocate();
+  Timer& timer = m_timers[index];
+  timer.expiry = expiry;
+  timer.callback = std::move(callback);
+  insert(index);
+  ++m_nPending;
+
+  if (expiry < m_wakeupTick && !m_isExpiring) {
+    // (expire() reschedules wakeup after all callbacks are done)
+    scheduleWakeup();
+  }
+
+  return TimerId(index, m_timers[index].generation);
+}
+
+void
+TimerWheel::cancel(TimerId& id)
+{
+  if (isPending(id)) {
+    unlink(id.m_index);
+    release(id.m_index);
+    --m_nPending;
+
+    if (m_nPending == 0 && m_wakeupEvent.IsRunning()) {
+      Simulator::Remove(m_wakeupEvent);
+      m_wakeupTick = NO_WAKEUP;
+    }
+  }
+  id = TimerId();
+}
+
+bool
+TimerWheel::isPending(const TimerId& id) const
+{
+  return id.m_index < m_timers.size() &&
+         m_timers[id.m_index].generation == id.m_generation &&
+         m_timers[id.m_index].slot != INVALID_INDEX;
+}
+
+uint64_t
+TimerWheel::getCurrentTick() const
+{
+  return Simulator::Now().GetTimeStep() / m_resolution.GetTimeStep();
+}
+
+uint32_t
+TimerWheel::allocate()
+{
+  uint32_t index = m_freeList;
+  if (index != INVALID_INDEX) {
+    m_freeList = m_timers[index].next;
+  }
+  else {
+    index = m_timers.size();
+    m_timers.emplace_back();
+  }
+
+  m_timers[index].prev = INVALID_INDEX;
+  m_timers[index].next = INVALID_INDEX;
+  return index;
+}
+
+void
+TimerWheel::release(uint32_t index)
+{
+  Timer& timer = m_timers[index];
+  timer.callback = nullptr;
+  ++timer.generation;
+  timer.slot = INVALID_INDEX;
+  timer.prev = INVALID_INDEX;
+  timer.next = m_freeList;
+  m_freeList = index;
+}
+
+void
+TimerWheel::insert(uint32_t index)
+{
+  static const uint64_t maxDelta = (uint64_t(1) << (SLOT_BITS * N_LEVELS)) - 1;
+
+  uint64_t expiry = m_timers[index].expiry;
+  uint64_t delta = expiry > m_currentTick ? expiry - m_currentTick : 0;
+  if (delta > maxDelta) {
+    // park in the farthest slot, the timer will be re-inserted when the slot is cascaded
+    delta = maxDelta;
+    expiry = m_currentTick + maxDelta;
+  }
+
+  int level = 0;
+  while (level < N_LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+    ++level;
+  }
+
+  uint32_t slot = level * N_SLOTS + ((expiry >> (SLOT_BITS * level)) & (N_SLOTS - 1));
+  link(index, slot);
+}
+
+uint32_t&
+TimerWheel::getHead(uint32_t slot)
+{
+  return slot == FIRING_SLOT ? m_firingHead : m_heads[slot];
+}
+
+void
+TimerWheel::link(uint32_t index, uint32_t slot)
+{
+  uint32_t& head = getHead(slot);
+
+  Timer& timer = m_timers[index];
+  timer.slot = slot;
+  timer.prev = INVALID_INDEX;
+  timer.next = head;
+  if (head != INVALID_INDEX) {
+    m_timers[head].prev = index;
+  }
+  head = index;
+
+  if (slot != FIRING_SLOT) {
+    ++m_nInLevel[slot / N_SLOTS];
+    m_bitmap[slot / 64] |= uint64_t(1) << (slot % 64);
+  }
+}
+
+void
+TimerWheel::unlink(uint32_t index)
+{
+  Timer& timer = m_timers[index];
+  uint32_t& head = getHead(timer.slot);
+
+  if (timer.prev != INVALID_INDEX) {
+    m_timers[timer.prev].next = timer.next;
+  }
+  else {
+    head = timer.next;
+  }
+  if (timer.next != INVALID_INDEX) {
+    m_timers[timer.next].prev = timer.prev;
+  }
+
+  if (timer.slot != FIRING_SLOT) {
+    --m_nInLevel[timer.slot / N_SLOTS];
+    if (head == INVALID_INDEX) {
+      m_bitmap[timer.slot / 64] &= ~(uint64_t(1) << (timer.slot % 64));
+    }
+  }
+
+  timer.prev = INVALID_INDEX;
+  timer.next = INVALID_INDEX;
+}
+
+void
+TimerWheel::cascade(int level)
+{
+  uint32_t slot = level * N_SLOTS + ((m_currentTick >> (SLOT_BITS * level)) & (N_SLOTS - 1));
+  while (m_heads[slot] != INVALID_INDEX) {
+    uint32_t index = m_heads[slot];
+    unlink(index);
+    insert(index);
+  }
+}
+
+bool
+TimerWheel::findNextSlot(int level, uint32_t start, uint32_t nSlots, uint32_t& offset) const
+{
+  const uint64_t* bitmap = m_bitmap + level * N_SLOTS / 64;
+  for (uint32_t i = 0; i < nSlots;) {
+    uint32_t slot = (start + i) & (N_SLOTS - 1);
+    uint64_t word = bitmap[slot / 64] >> (slot % 64);
+    if (word != 0) {
+      offset = i + __builtin_ctzll(word);
+      return offset < nSlots;
+    }
+    i += 64 - slot % 64;
+  }
+  return false;
+}
+
+bool
+TimerWheel::findNextTick(uint64_t& tick) const
+{
+  bool isFound = false;
+  uint32_t offset = 0;
+
+  // first-level slots for ticks m_currentTick + 1 ... m_currentTick + N_SLOTS - 1
+  if (findNextSlot(0, (m_currentTick + 1) & (N_SLOTS - 1), N_SLOTS - 1, offset)) {
+    tick = m_currentTick + 1 + offset;
+    isFound = true;
+  }
+
+  // timers in upper levels are cascaded when the tick reaches the start of their slot
+  for (int level = 1; level < N_LEVELS; ++level) {
+    if (m_nInLevel[level] == 0) {
+      continue;
+    }
+
+    uint64_t next = (m_currentTick >> (SLOT_BITS * level)) + 1;
+    if (findNextSlot(level, next & (N_SLOTS - 1), N_SLOTS, offset)) {
+      uint64_t boundary = (next + offset) << (SLOT_BITS * level);
+      tick = isFound ? std::min(tick, boundary) : boundary;
+      isFound = true;
+    }
+  }
+
+  return isFound;
+}
+
+void
+TimerWheel::scheduleWakeup()
+{
+  if (m_wakeupEvent.IsRunning()) {
+    Simulator::Remove(m_wakeupEvent);
+  }
+  m_wakeupTick = NO_WAKEUP;
+
+  if (m_nPending == 0) {
+    return;
+  }
+
+  uint64_t next = 0;
+  if (!findNextTick(next)) {
+    return;
+  }
+
+  m_wakeupTick = std::max(next, getCurrentTick());
+  Time when = TimeStep(m_wakeupTick * m_resolution.GetTimeStep());
+  m_wakeupEvent = Simulator::Schedule(when - Simulator::Now(), &TimerWheel::expire, this);
+}
+
+void
+TimerWheel::expire()
+{
+  m_wakeupTick = NO_WAKEUP;
+  uint64_t target = getCurrentTick();
+
+  m_isExpiring = true;
+  while (m_nPending > 0) {
+    uint64_t next = 0;
+    if (!findNextTick(next) || next > target) {
+      break;
+    }
+
+    m_currentTick = next;
+    for (int level = N_LEVELS - 1; level > 0; --level) {
+      if ((m_currentTick & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+        cascade(level);
+      }
+    }
+
+    // detach the slot, so callbacks can freely schedule and cancel other timers
+    uint32_t slot = m_currentTick & (N_SLOTS - 1);
+    while (m_heads[slot] != INVALID_INDEX) {
+      uint32_t index = m_heads[slot];
+      unlink(index);
+      link(index, FIRING_SLOT);
+    }
+
+    while (m_firingHead != INVALID_INDEX) {
+      uint32_t index = m_firingHead;
+      unlink(index);
+      Callback callback = std::move(m_timers[index].callback);
+      release(index);
+      --m_nPending;
+
+      callback();
+    }
+  }
+  m_isExpiring = false;
+
+  m_currentTick = std::max(m_currentTick, target);
+  scheduleWakeup();
+}
+
+} // namespace ndn
+} // namespace ns3
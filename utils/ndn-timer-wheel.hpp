@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_TIMER_WHEEL_HPP
+#define NDNSIM_UTILS_NDN_TIMER_WHEEL_HPP
+
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Hierarchical timer wheel for large numbers of short-lived cancellable timers
+ *
+ * Timers are rounded up to the wheel resolution and kept in three levels of 256 slots
+ * (2^24 ticks in total; later timers are parked in the last level and re-inserted).  Scheduling
+ * and cancellation are O(1) and do not touch the global ns-3 scheduler: the wheel keeps at most
+ * one ns-3 event, for the nearest non-empty tick (or the next cascade boundary).
+ *
+ * Callbacks are invoked in the context the wheel was first used from, so a wheel must not be
+ * shared between nodes.
+ */
+class TimerWheel : boost::noncopyable {
+public:
+  typedef std::function<void()> Callback;
+
+  /**
+   * @brief Opaque handle of a scheduled timer
+   *
+   * A handle stays safe to use after the timer fires or is cancelled.
+   */
+  class TimerId {
+  public:
+    TimerId() = default;
+
+    explicit
+    operator bool() const
+    {
+      return m_index != INVALID_INDEX;
+    }
+
+  private:
+    TimerId(uint32_t index, uint32_t generation)
+      : m_index(index)
+      , m_generation(generation)
+    {
+    }
+
+  private:
+    uint32_t m_index = INVALID_INDEX;
+    uint32_t m_generation = 0;
+
+    friend class TimerWheel;
+  };
+
+  /**
+   * @param resolution duration of a single tick
+   */
+  explicit
+  TimerWheel(Time resolution = MilliSeconds(1));
+
+  ~TimerWheel();
+
+  /**
+   * @brief Schedule @p callback to be called after @p delay (rounded up to the resolution)
+   */
+  TimerId
+  schedule(Time delay, Callback callback);
+
+  /**
+   * @brief Cancel timer, no-op if it already fired or was cancelled
+   */
+  void
+  cancel(TimerId& id);
+
+  /**
+   * @brief Check whether the timer is still pending
+   */
+  bool
+  isPending(const TimerId& id) const;
+
+  /**
+   * @brief Number of pending timers
+   */
+  size_t
+  size() const
+  {
+    return m_nPending;
+  }
+
+  Time
+  getResolution() const
+  {
+    return m_resolution;
+  }
+
+private:
+  static const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+  static const uint32_t FIRING_SLOT = 0xFFFFFFFE;
+
+  static const int SLOT_BITS = 8;
+  static const uint32_t N_SLOTS = 1 << SLOT_BITS;
+  static const int N_LEVELS = 3;
+
+  struct Timer
+  {
+    uint64_t expiry = 0;
+    Callback callback;
+    uint32_t generation = 0;
+    uint32_t slot = INVALID_INDEX; // INVALID_INDEX if timer is in the free list
+    uint32_t prev = INVALID_INDEX;
+    uint32_t next = INVALID_INDEX;
+  };
+
+  uint64_t
+  getCurrentTick() const;
+
+  uint32_t
+  allocate();
+
+  void
+  release(uint32_t index);
+
+  void
+  insert(uint32_t index);
+
+  void
+  link(uint32_t index, uint32_t slot);
+
+  void
+  unlink(uint32_t index);
+
+  uint32_t&
+  getHead(uint32_t slot);
+
+  void
+  cascade(int level);
+
+  void
+  expire();
+
+  void
+  scheduleWakeup();
+
+  /**
+   * @brief Find the first non-empty slot of @p level among @p nSlots slots starting from @p start
+   * @param[out] offset distance of the found slot from @p start
+   */
+  bool
+  findNextSlot(int level, uint32_t start, uint32_t nSlots, uint32_t& offset) const;
+
+  /**
+   * @brief Find the nearest tick after m_currentTick that needs processing
+   *
+   * This is either the expiry of a first-level slot or the start of a non-empty upper-level
+   * slot, where its timers are cascaded.
+   *
+   * @return false if the wheel is empty
+   */
+  bool
+  findNextTick(uint64_t& tick) const;
+
+private:
+  Time m_resolution;
+
+  std::vector<Timer> m_timers;
+  uint32_t m_freeList;
+  size_t m_nPending;
+
+  uint32_t m_heads[N_LEVELS * N_SLOTS];
+  uint32_t m_nInLevel[N_LEVELS];
+  uint64_t m_bitmap[N_LEVELS * N_SLOTS / 64]; ///< non-empty slots
+  uint32_t m_firingHead;
+
+  uint64_t m_currentTick; ///< all timers expiring at or before this tick were fired
+  EventId m_wakeupEvent;
+  uint64_t m_wakeupTick;
+  bool m_isExpiring;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_TIMER_WHEEL_HPP
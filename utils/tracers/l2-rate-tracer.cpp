@@ -28,6 +28,8 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 
+#include "ndn-trace-sink.hpp"
+
 #include <boost/lexical_cast.hpp>
 #include <fstream>
 
@@ -35,6 +37,29 @@ NS_LOG_COMPONENT_DEFINE("L2RateTracer");
 
 namespace ns3 {
 
+namespace {
+
+enum : uint16_t {
+  RATE_RECORD = 1
+};
+
+struct RateRecord
+{
+  int64_t time;       ///< simulation time, in time steps
+  uint32_t node;      ///< string id of the node name
+  uint32_t interface; ///< string id of the interface description
+  uint32_t type;      ///< string id of the packet type
+  uint32_t reserved;
+  uint64_t packets;
+  uint64_t kilobytes;
+  uint64_t packetsRaw;
+  double kilobytesRaw;
+};
+
+static_assert(sizeof(RateRecord) == 56, "Unexpected padding in RateRecord");
+
+} // namespace
+
 static std::list<std::tuple<std::shared_ptr<std::ostream>, std::list<Ptr<L2RateTracer>>>>
   g_tracers;
 
@@ -49,30 +74,21 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 {
   std::list<Ptr<L2RateTracer>> tracers;
   std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  std::shared_ptr<ndn::TraceSink> sink;
+  if (!ndn::TraceSink::OpenOutput(file, ndn::TraceSink::L2_RATE, outputStream, sink)) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
 
     Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
+    trace->SetSink(sink);
     trace->SetAveragingPeriod(averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -84,6 +100,7 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
   : L2Tracer(node)
   , m_os(os)
+  , m_nodeStringId(0)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -101,17 +118,31 @@ L2RateTracer::SetAveragingPeriod(const Time& period)
   m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
 }
 
+void
+L2RateTracer::SetSink(std::shared_ptr<ndn::TraceSink> sink)
+{
+  m_sink = std::move(sink);
+  if (m_sink != nullptr) {
+    m_nodeStringId = m_sink->GetStringId(m_node);
+  }
+}
+
 void
 L2RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_sink != nullptr) {
+    Write(*m_sink);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
 }
 
-void
-L2RateTracer::PrintHeader(std::ostream& os) const
+static void
+printHeader(std::ostream& os)
 {
   os << "Time"
      << "\t"
@@ -132,6 +163,21 @@ L2RateTracer::PrintHeader(std::ostream& os) const
      << "KilobytesRaw";
 }
 
+static void
+printLine(std::ostream& os, Time time, const std::string& node, const std::string& interface,
+          const std::string& type, uint64_t packets, uint64_t kilobytes, uint64_t packetsRaw,
+          double kilobytesRaw)
+{
+  os << time.ToDouble(Time::S) << "\t" << node << "\t" << interface << "\t" << type << "\t"
+     << packets << "\t" << kilobytes << "\t" << packetsRaw << "\t" << kilobytesRaw << "\n";
+}
+
+void
+L2RateTracer::PrintHeader(std::ostream& os) const
+{
+  printHeader(os);
+}
+
 void
 L2RateTracer::Reset()
 {
@@ -150,18 +196,66 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName << "\t" \
-     << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t" << STATS(0).fieldName << "\t"     \
-     << STATS(1).fieldName / 1024.0 << "\n";
+  report(interface, printName, STATS(2).fieldName, STATS(3).fieldName, STATS(0).fieldName,        \
+         STATS(1).fieldName / 1024.0);
 
 void
 L2RateTracer::Print(std::ostream& os) const
 {
   Time time = Simulator::Now();
 
+  Update([&] (const char* interface, const char* type, uint64_t packets, uint64_t kilobytes,
+              uint64_t packetsRaw, double kilobytesRaw) {
+      printLine(os, time, m_node, interface, type, packets, kilobytes, packetsRaw, kilobytesRaw);
+    });
+}
+
+void
+L2RateTracer::Write(ndn::TraceSink& sink) const
+{
+  int64_t time = Simulator::Now().GetTimeStep();
+
+  Update([&] (const char* interface, const char* type, uint64_t packets, uint64_t kilobytes,
+              uint64_t packetsRaw, double kilobytesRaw) {
+      RateRecord record = {time, m_nodeStringId, sink.GetStringId(interface),
+                           sink.GetStringId(type), 0, packets, kilobytes, packetsRaw,
+                           kilobytesRaw};
+      sink.Append(RATE_RECORD, record);
+    });
+}
+
+void
+L2RateTracer::Update(const Reporter& report) const
+{
   PRINTER("Drop", m_drop, "combined");
 }
 
+size_t
+L2RateTracer::ConvertToTsv(ndn::TraceReader& reader, std::ostream& os)
+{
+  if (reader.GetFormat() != ndn::TraceSink::L2_RATE) {
+    throw std::runtime_error("Not an L2 rate trace");
+  }
+
+  printHeader(os);
+  os << "\n";
+
+  size_t nRecords = 0;
+  ndn::TraceReader::Entry entry;
+  while (reader.Next(entry)) {
+    if (entry.type != RATE_RECORD) {
+      continue;
+    }
+
+    auto record = entry.as<RateRecord>();
+    printLine(os, reader.GetTime(record.time), reader.GetString(record.node),
+              reader.GetString(record.interface), reader.GetString(record.type), record.packets,
+              record.kilobytes, record.packetsRaw, record.kilobytesRaw);
+    ++nRecords;
+  }
+  return nRecords;
+}
+
 void
 L2RateTracer::Drop(Ptr<const Packet> packet)
 {
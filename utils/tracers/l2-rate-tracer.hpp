@@ -25,11 +25,17 @@
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 
+#include <functional>
 #include <tuple>
 #include <map>
 
 namespace ns3 {
 
+namespace ndn {
+class TraceSink;
+class TraceReader;
+} // namespace ndn
+
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to collect link-layer rate information about links
@@ -47,7 +53,9 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin or .bin.gz, binary records are written using
+   *             ndn::TraceSink
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -81,7 +89,37 @@ public:
   virtual void
   Drop(Ptr<const Packet>);
 
+  /**
+   * @brief Convert binary trace (see ndn::TraceSink) into the tab-separated format, with header
+   * @return number of converted records
+   * @throw std::runtime_error if the trace is not an L2 rate trace or is malformed
+   */
+  static size_t
+  ConvertToTsv(ndn::TraceReader& reader, std::ostream& os);
+
 private:
+  typedef std::function<void(const char* interface, const char* type, uint64_t packets,
+                             uint64_t kilobytes, uint64_t packetsRaw, double kilobytesRaw)>
+    Reporter;
+
+  /**
+   * @brief Update averaged rates and pass them to @p report
+   */
+  void
+  Update(const Reporter& report) const;
+
+  /**
+   * @brief Write current rates as binary records
+   */
+  void
+  Write(ndn::TraceSink& sink) const;
+
+  /**
+   * @brief Write records into binary @p sink instead of the text stream, if not nullptr
+   */
+  void
+  SetSink(std::shared_ptr<ndn::TraceSink> sink);
+
   void
   PeriodicPrinter();
 
@@ -90,6 +128,8 @@ private:
 
 private:
   std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::TraceSink> m_sink;
+  uint32_t m_nodeStringId;
   Time m_period;
   EventId m_printEvent;
 
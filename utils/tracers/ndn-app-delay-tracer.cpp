@@ -29,6 +29,8 @@
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "ndn-trace-sink.hpp"
+
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
@@ -39,6 +41,29 @@ NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 namespace ns3 {
 namespace ndn {
 
+namespace {
+
+enum : uint16_t {
+  LAST_DELAY_RECORD = 1,
+  FULL_DELAY_RECORD = 2
+};
+
+struct DelayRecord
+{
+  int64_t time;     ///< simulation time, in time steps
+  int64_t delay;    ///< in time steps
+  uint32_t node;    ///< string id of the node name
+  uint32_t appId;
+  uint32_t seqNo;
+  uint32_t retxCount;
+  int32_t hopCount;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(DelayRecord) == 40, "Unexpected padding in DelayRecord");
+
+} // namespace
+
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer>>>>
   g_tracers;
 
@@ -56,27 +81,18 @@ AppDelayTracer::InstallAll(const std::string& file)
 
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::APP_DELAY, outputStream, sink)) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    trace->SetSink(sink);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -93,27 +109,18 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::APP_DELAY, outputStream, sink)) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
     Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    trace->SetSink(sink);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -130,25 +137,16 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
 
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::APP_DELAY, outputStream, sink)) {
+    return;
   }
 
   Ptr<AppDelayTracer> trace = Install(node, outputStream);
+  trace->SetSink(sink);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -174,6 +172,7 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_nodeStringId(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,6 +187,7 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_nodeStringId(0)
 {
   Connect();
 }
@@ -207,7 +207,16 @@ AppDelayTracer::Connect()
 }
 
 void
-AppDelayTracer::PrintHeader(std::ostream& os) const
+AppDelayTracer::SetSink(shared_ptr<TraceSink> sink)
+{
+  m_sink = std::move(sink);
+  if (m_sink != nullptr) {
+    m_nodeStringId = m_sink->GetStringId(m_node);
+  }
+}
+
+static void
+printHeader(std::ostream& os)
 {
   os << "Time"
      << "\t"
@@ -230,26 +239,73 @@ AppDelayTracer::PrintHeader(std::ostream& os) const
      << "";
 }
 
+static void
+printLine(std::ostream& os, Time time, const std::string& node, uint32_t appId, uint32_t seqno,
+          const char* type, Time delay, uint32_t retxCount, int32_t hopCount)
+{
+  os << time.ToDouble(Time::S) << "\t" << node << "\t" << appId << "\t" << seqno << "\t"
+     << type << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t"
+     << retxCount << "\t" << hopCount << "\n";
+}
+
+void
+AppDelayTracer::PrintHeader(std::ostream& os) const
+{
+  printHeader(os);
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount << "\n";
+  if (m_sink != nullptr) {
+    DelayRecord record = {Simulator::Now().GetTimeStep(), delay.GetTimeStep(), m_nodeStringId,
+                          app->GetId(), seqno, 1, hopCount, 0};
+    m_sink->Append(LAST_DELAY_RECORD, record);
+    return;
+  }
+
+  printLine(*m_os, Simulator::Now(), m_node, app->GetId(), seqno, "LastDelay", delay, 1, hopCount);
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount << "\n";
+  if (m_sink != nullptr) {
+    DelayRecord record = {Simulator::Now().GetTimeStep(), delay.GetTimeStep(), m_nodeStringId,
+                          app->GetId(), seqno, retxCount, hopCount, 0};
+    m_sink->Append(FULL_DELAY_RECORD, record);
+    return;
+  }
+
+  printLine(*m_os, Simulator::Now(), m_node, app->GetId(), seqno, "FullDelay", delay, retxCount,
+            hopCount);
+}
+
+size_t
+AppDelayTracer::ConvertToTsv(TraceReader& reader, std::ostream& os)
+{
+  if (reader.GetFormat() != TraceSink::APP_DELAY) {
+    throw std::runtime_error("Not an application delay trace");
+  }
+
+  printHeader(os);
+  os << "\n";
+
+  size_t nRecords = 0;
+  TraceReader::Entry entry;
+  while (reader.Next(entry)) {
+    if (entry.type != LAST_DELAY_RECORD && entry.type != FULL_DELAY_RECORD) {
+      continue;
+    }
+    DelayRecord record = entry.as<DelayRecord>();
+    printLine(os, reader.GetTime(record.time), reader.GetString(record.node), record.appId,
+              record.seqNo, entry.type == LAST_DELAY_RECORD ? "LastDelay" : "FullDelay",
+              reader.GetTime(record.delay), record.retxCount, record.hopCount);
+    ++nRecords;
+  }
+  return nRecords;
 }
 
 } // namespace ndn
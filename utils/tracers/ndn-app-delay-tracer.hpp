@@ -39,6 +39,8 @@ class Packet;
 namespace ndn {
 
 class App;
+class TraceSink;
+class TraceReader;
 
 /**
  * @ingroup ndn-tracers
@@ -49,8 +51,9 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin or .bin.gz, binary records are written using
+   *             TraceSink
    */
   static void
   InstallAll(const std::string& file);
@@ -127,10 +130,24 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Convert binary trace (see TraceSink) into the tab-separated format, with header
+   * @return number of converted records
+   * @throw std::runtime_error if the trace is not an application delay trace or is malformed
+   */
+  static size_t
+  ConvertToTsv(TraceReader& reader, std::ostream& os);
+
 private:
   void
   Connect();
 
+  /**
+   * @brief Write records into binary @p sink instead of the text stream, if not nullptr
+   */
+  void
+  SetSink(shared_ptr<TraceSink> sink);
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -143,6 +160,8 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
+  uint32_t m_nodeStringId;
 };
 
 } // namespace ndn
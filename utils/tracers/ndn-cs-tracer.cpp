@@ -29,6 +29,8 @@
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "ndn-trace-sink.hpp"
+
 #include <boost/lexical_cast.hpp>
 
 #include <fstream>
@@ -38,6 +40,24 @@ NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 namespace ns3 {
 namespace ndn {
 
+namespace {
+
+enum : uint16_t {
+  CS_RECORD = 1
+};
+
+struct CsRecord
+{
+  int64_t time;  ///< simulation time, in time steps
+  double value;
+  uint32_t node; ///< string id of the node name
+  uint32_t type; ///< string id of the counter name
+};
+
+static_assert(sizeof(CsRecord) == 24, "Unexpected padding in CsRecord");
+
+} // namespace
+
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
 
 void
@@ -54,27 +74,18 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
 
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::CS, outputStream, sink)) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->SetSink(sink);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -92,27 +103,18 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
 
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::CS, outputStream, sink)) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
     Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->SetSink(sink);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -130,25 +132,16 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
 
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::CS, outputStream, sink)) {
+    return;
   }
 
   Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
+  trace->SetSink(sink);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -176,6 +169,7 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_nodeStringId(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -190,6 +184,7 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_nodeStringId(0)
 {
   Connect();
 }
@@ -215,17 +210,31 @@ CsTracer::SetAveragingPeriod(const Time& period)
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
 
+void
+CsTracer::SetSink(shared_ptr<TraceSink> sink)
+{
+  m_sink = std::move(sink);
+  if (m_sink != nullptr) {
+    m_nodeStringId = m_sink->GetStringId(m_node);
+  }
+}
+
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_sink != nullptr) {
+    Write(*m_sink);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
 
-void
-CsTracer::PrintHeader(std::ostream& os) const
+static void
+printHeader(std::ostream& os)
 {
   os << "Time"
      << "\t"
@@ -239,25 +248,80 @@ CsTracer::PrintHeader(std::ostream& os) const
      << "\t";
 }
 
+static void
+printLine(std::ostream& os, Time time, const std::string& node, const std::string& type,
+          double value)
+{
+  os << time.ToDouble(Time::S) << "\t" << node << "\t" << type << "\t" << value << "\n";
+}
+
+void
+CsTracer::PrintHeader(std::ostream& os) const
+{
+  printHeader(os);
+}
+
 void
 CsTracer::Reset()
 {
   m_stats.Reset();
 }
 
-#define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+#define PRINTER(printName, fieldName) report(printName, m_stats.fieldName);
 
 void
 CsTracer::Print(std::ostream& os) const
 {
   Time time = Simulator::Now();
 
+  Update([&] (const char* type, double value) {
+      printLine(os, time, m_node, type, value);
+    });
+}
+
+void
+CsTracer::Write(TraceSink& sink) const
+{
+  int64_t time = Simulator::Now().GetTimeStep();
+
+  Update([&] (const char* type, double value) {
+      CsRecord record = {time, value, m_nodeStringId, sink.GetStringId(type)};
+      sink.Append(CS_RECORD, record);
+    });
+}
+
+void
+CsTracer::Update(const Reporter& report) const
+{
   PRINTER("CacheHits", m_cacheHits);
   PRINTER("CacheMisses", m_cacheMisses);
 }
 
+size_t
+CsTracer::ConvertToTsv(TraceReader& reader, std::ostream& os)
+{
+  if (reader.GetFormat() != TraceSink::CS) {
+    throw std::runtime_error("Not a content store trace");
+  }
+
+  printHeader(os);
+  os << "\n";
+
+  size_t nRecords = 0;
+  TraceReader::Entry entry;
+  while (reader.Next(entry)) {
+    if (entry.type != CS_RECORD) {
+      continue;
+    }
+
+    auto record = entry.as<CsRecord>();
+    printLine(os, reader.GetTime(record.time), reader.GetString(record.node),
+              reader.GetString(record.type), record.value);
+    ++nRecords;
+  }
+  return nRecords;
+}
+
 void
 CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
 {
@@ -28,6 +28,7 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
+#include <functional>
 #include <tuple>
 #include <map>
 #include <list>
@@ -39,6 +40,9 @@ class Packet;
 
 namespace ndn {
 
+class TraceSink;
+class TraceReader;
+
 namespace cs {
 
 /// @cond include_hidden
@@ -64,7 +68,9 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin or .bin.gz, binary records are written using
+   *             TraceSink
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -168,7 +174,35 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Convert binary trace (see TraceSink) into the tab-separated format, with header
+   * @return number of converted records
+   * @throw std::runtime_error if the trace is not a content store trace or is malformed
+   */
+  static size_t
+  ConvertToTsv(TraceReader& reader, std::ostream& os);
+
 private:
+  typedef std::function<void(const char* type, double value)> Reporter;
+
+  /**
+   * @brief Pass current counters to @p report
+   */
+  void
+  Update(const Reporter& report) const;
+
+  /**
+   * @brief Write current counters as binary records
+   */
+  void
+  Write(TraceSink& sink) const;
+
+  /**
+   * @brief Write records into binary @p sink instead of the text stream, if not nullptr
+   */
+  void
+  SetSink(shared_ptr<TraceSink> sink);
+
   void
   Connect();
 
@@ -193,6 +227,8 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
+  uint32_t m_nodeStringId;
 
   Time m_period;
   EventId m_printEvent;
@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-geocast-action-tracer.hpp"
+
+#include "ns3/ndnSIM/model/directed-geocast-strategy.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+
+#include <cstring>
+#include <limits>
+#include <list>
+#include <stdexcept>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GeocastActionTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static_assert(sizeof(GeocastActionTracer::Record) == 40, "Unexpected padding in Record");
+
+const uint64_t GeocastActionTracer::NO_SEQ_NO = std::numeric_limits<uint64_t>::max();
+
+static const char MAGIC[8] = {'N', 'D', 'N', 'G', 'E', 'O', 'A', '1'};
+static const size_t BUFFER_SIZE = 64 * 1024; // records, 2.5 MiB
+
+static std::list<std::unique_ptr<GeocastActionTracer>> g_tracers;
+
+void
+GeocastActionTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+static shared_ptr<std::ofstream>
+openTraceFile(const std::string& file)
+{
+  auto os = make_shared<std::ofstream>();
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+
+  uint32_t recordSize = sizeof(GeocastActionTracer::Record);
+  os->write(MAGIC, sizeof(MAGIC));
+  os->write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+  return os;
+}
+
+void
+GeocastActionTracer::InstallAll(const std::string& file)
+{
+  auto os = openTraceFile(file);
+  if (os == nullptr) {
+    return;
+  }
+
+  g_tracers.push_back(make_unique<GeocastActionTracer>(os, std::vector<bool>()));
+}
+
+void
+GeocastActionTracer::Install(const NodeContainer& nodes, const std::string& file)
+{
+  auto os = openTraceFile(file);
+  if (os == nullptr) {
+    return;
+  }
+
+  std::vector<bool> selected;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    uint32_t id = (*node)->GetId();
+    if (id >= selected.size()) {
+      selected.resize(id + 1, false);
+    }
+    selected[id] = true;
+  }
+
+  g_tracers.push_back(make_unique<GeocastActionTracer>(os, std::move(selected)));
+}
+
+GeocastActionTracer::GeocastActionTracer(shared_ptr<std::ofstream> os, std::vector<bool> nodes)
+  : m_os(std::move(os))
+  , m_nodes(std::move(nodes))
+{
+  m_buffer.reserve(BUFFER_SIZE);
+  m_connection = nfd::fw::DirectedGeocastStrategy::onAction.connect(
+    [this] (const Name& name, int action, double x, double y) {
+      this->onAction(name, action, x, y);
+    });
+}
+
+GeocastActionTracer::~GeocastActionTracer()
+{
+  Flush();
+}
+
+void
+GeocastActionTracer::onAction(const Name& name, int action, double x, double y)
+{
+  uint32_t node = Simulator::GetContext();
+  if (!m_nodes.empty() && (node >= m_nodes.size() || !m_nodes[node])) {
+    return;
+  }
+
+  Record record;
+  std::memset(&record, 0, sizeof(record));
+  record.time = Simulator::Now().ToDouble(Time::S);
+  record.x = x;
+  record.y = y;
+  record.seqNo = !name.empty() && name.get(-1).isSequenceNumber() ?
+                 name.get(-1).toSequenceNumber() : NO_SEQ_NO;
+  record.node = node;
+  record.action = static_cast<uint8_t>(action);
+
+  m_buffer.push_back(record);
+  if (m_buffer.size() >= BUFFER_SIZE) {
+    Flush();
+  }
+}
+
+void
+GeocastActionTracer::Flush()
+{
+  if (!m_buffer.empty()) {
+    m_os->write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size() * sizeof(Record));
+    m_buffer.clear();
+  }
+  m_os->flush();
+}
+
+static const char*
+getActionName(uint8_t action)
+{
+  switch (action) {
+  case nfd::fw::DirectedGeocastStrategy::Sent:
+    return "Broadcast";
+  case nfd::fw::DirectedGeocastStrategy::Received:
+    return "Received";
+  case nfd::fw::DirectedGeocastStrategy::ReceivedDup:
+    return "Duplicate";
+  default:
+    return "Suppressed";
+  }
+}
+
+size_t
+GeocastActionTracer::ConvertToCsv(const std::string& file, std::ostream& os)
+{
+  std::ifstream is(file.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    throw std::runtime_error("Cannot open " + file);
+  }
+
+  char magic[sizeof(MAGIC)];
+  uint32_t recordSize = 0;
+  is.read(magic, sizeof(magic));
+  is.read(reinterpret_cast<char*>(&recordSize), sizeof(recordSize));
+  if (!is || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || recordSize != sizeof(Record)) {
+    throw std::runtime_error(file + " is not a geocast action trace");
+  }
+
+  // same columns as the CSV written by the V2V examples; Name holds the sequence number
+  os << "Node,Time,Name,Action,X,Y\n";
+
+  size_t nRecords = 0;
+  std::vector<Record> buffer(BUFFER_SIZE);
+  while (is) {
+    is.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(Record));
+    size_t nRead = is.gcount() / sizeof(Record);
+
+    for (size_t i = 0; i < nRead; ++i) {
+      const Record& record = buffer[i];
+      os << record.node << "," << record.time << ",";
+      if (record.seqNo != NO_SEQ_NO) {
+        os << record.seqNo;
+      }
+      os << "," << getActionName(record.action) << "," << record.x << "," << record.y << "\n";
+    }
+    nRecords += nRead;
+  }
+
+  return nRecords;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GEOCAST_ACTION_TRACER_HPP
+#define NDN_GEOCAST_ACTION_TRACER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node-container.h"
+
+#include <ndn-cxx/util/signal.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <fstream>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Binary tracer of DirectedGeocastStrategy actions (Broadcast, Received, Duplicate,
+ *        Suppressed)
+ *
+ * Each action is stored as a fixed-size GeocastActionTracer::Record.  Records are accumulated
+ * in memory and appended to the output file in large blocks, which is much cheaper than
+ * formatting (and flushing) a CSV line for every event.  The resulting file can be converted to
+ * CSV with GeocastActionTracer::ConvertToCsv or the `geocast-trace-to-csv` program:
+ *
+ *     ./waf --run "geocast-trace-to-csv --input=geocast-trace.bin --output=geocast-trace.csv"
+ *
+ * The binary file starts with 8-byte magic "NDNGEOA1" and 4-byte record size, followed by
+ * records in the host byte order.
+ */
+class GeocastActionTracer : boost::noncopyable {
+public:
+  struct Record
+  {
+    double time;     ///< simulation time, in seconds
+    double x;        ///< position of the node
+    double y;
+    uint64_t seqNo;  ///< sequence number (last name component), or NO_SEQ_NO
+    uint32_t node;   ///< node ID (simulation context)
+    uint8_t action;  ///< DirectedGeocastStrategy action (Sent, Received, ReceivedDup, Canceled)
+    uint8_t reserved[3];
+  };
+
+  static const uint64_t NO_SEQ_NO;
+
+  /**
+   * @brief Trace actions on all nodes into @p file
+   */
+  static void
+  InstallAll(const std::string& file);
+
+  /**
+   * @brief Trace actions on the selected nodes into @p file
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file);
+
+  /**
+   * @brief Flush and remove all tracers
+   *
+   * Tracers are also flushed on program exit, calling Destroy is necessary only if trace file
+   * needs to be processed before that.
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Convert binary trace into CSV with "Node,Time,Name,Action,X,Y" columns
+   *
+   * The columns are the same as in CSV files written directly by the V2V examples; the Name
+   * column holds the sequence number (last name component) of the Interest.
+   * @return number of converted records
+   * @throw std::runtime_error if @p file cannot be read or is not a geocast action trace
+   */
+  static size_t
+  ConvertToCsv(const std::string& file, std::ostream& os);
+
+  /**
+   * @param os           opened binary output stream
+   * @param nodes        node IDs to trace; all nodes if empty
+   */
+  GeocastActionTracer(shared_ptr<std::ofstream> os, std::vector<bool> nodes);
+
+  ~GeocastActionTracer();
+
+  void
+  Flush();
+
+private:
+  void
+  onAction(const Name& name, int action, double x, double y);
+
+private:
+  shared_ptr<std::ofstream> m_os;
+  std::vector<bool> m_nodes;
+  std::vector<Record> m_buffer;
+  ::ndn::util::signal::ScopedConnection m_connection;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GEOCAST_ACTION_TRACER_HPP
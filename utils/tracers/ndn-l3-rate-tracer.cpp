@@ -26,24 +26,65 @@
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-net-device-transport.hpp"
 
+#include "daemon/fw/forwarder.hpp"
 #include "daemon/table/pit-entry.hpp"
 
+#include "ndn-trace-sink.hpp"
+
 #include <fstream>
 #include <boost/lexical_cast.hpp>
+#include <boost/noncopyable.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
 
 namespace ns3 {
 namespace ndn {
 
+namespace {
+
+enum : uint16_t {
+  RATE_RECORD = 1
+};
+
+struct RateRecord
+{
+  int64_t time;       ///< simulation time, in time steps
+  uint64_t faceId;    ///< face ID, or nfd::face::INVALID_FACEID for node-wide values
+  uint32_t node;      ///< string id of the node name
+  uint32_t faceDescr; ///< string id of the face description
+  uint32_t type;      ///< string id of the packet type
+  uint32_t reserved;
+  double packets;
+  double kilobytes;
+  double packetsRaw;
+  double kilobytesRaw;
+};
+
+static_assert(sizeof(RateRecord) == 64, "Unexpected padding in RateRecord");
+
+} // namespace
+
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
   g_tracers;
 
+class L3RateAggregator;
+static std::list<shared_ptr<L3RateAggregator>> g_aggregators;
+
+static bool g_isTxQueueTraced = false;
+
 void
 L3RateTracer::Destroy()
 {
   g_tracers.clear();
+  g_aggregators.clear();
+}
+
+void
+L3RateTracer::SetTxQueueTracing(bool isEnabled)
+{
+  g_isTxQueueTraced = isEnabled;
 }
 
 void
@@ -51,27 +92,18 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 {
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::L3_RATE, outputStream, sink)) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->SetSink(sink);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -89,27 +121,18 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
 
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::L3_RATE, outputStream, sink)) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
     Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->SetSink(sink);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -127,25 +150,16 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
 
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::L3_RATE, outputStream, sink)) {
+    return;
   }
 
   Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
+  trace->SetSink(sink);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && outputStream != nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -169,6 +183,7 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
+  , m_nodeStringId(0)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -176,6 +191,7 @@ L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_nodeStringId(0)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -193,17 +209,31 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
+void
+L3RateTracer::SetSink(shared_ptr<TraceSink> sink)
+{
+  m_sink = std::move(sink);
+  if (m_sink != nullptr) {
+    m_nodeStringId = m_sink->GetStringId(m_node);
+  }
+}
+
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_sink != nullptr) {
+    Write(*m_sink);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
-void
-L3RateTracer::PrintHeader(std::ostream& os) const
+static void
+printHeader(std::ostream& os)
 {
   os << "Time"
      << "\t"
@@ -226,6 +256,28 @@ L3RateTracer::PrintHeader(std::ostream& os) const
      << "KilobytesRaw";
 }
 
+static void
+printLine(std::ostream& os, Time time, const std::string& node, nfd::FaceId faceId,
+          const std::string& faceDescr, const char* type, double packets, double kilobytes,
+          double packetsRaw, double kilobytesRaw)
+{
+  os << time.ToDouble(Time::S) << "\t" << node << "\t";
+  if (faceId != nfd::face::INVALID_FACEID) {
+    os << faceId << "\t" << faceDescr << "\t";
+  }
+  else {
+    os << "-1\tall\t";
+  }
+  os << type << "\t" << packets << "\t" << kilobytes << "\t" << packetsRaw << "\t"
+     << kilobytesRaw << "\n";
+}
+
+void
+L3RateTracer::PrintHeader(std::ostream& os) const
+{
+  printHeader(os);
+}
+
 void
 L3RateTracer::Reset()
 {
@@ -246,23 +298,47 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  report(stats.first, printName, STATS(2).fieldName, STATS(3).fieldName, STATS(0).fieldName,      \
+         STATS(1).fieldName / 1024.0);
 
 void
 L3RateTracer::Print(std::ostream& os) const
 {
   Time time = Simulator::Now();
 
+  Update([&] (nfd::FaceId faceId, const char* type, double packets, double kilobytes,
+              double packetsRaw, double kilobytesRaw) {
+      std::string faceDescr;
+      if (faceId != nfd::face::INVALID_FACEID) {
+        NS_ASSERT(m_faceInfos.find(faceId) != m_faceInfos.end());
+        faceDescr = m_faceInfos.find(faceId)->second;
+      }
+      printLine(os, time, m_node, faceId, faceDescr, type, packets, kilobytes, packetsRaw,
+                kilobytesRaw);
+    });
+}
+
+void
+L3RateTracer::Write(TraceSink& sink) const
+{
+  int64_t time = Simulator::Now().GetTimeStep();
+
+  Update([&] (nfd::FaceId faceId, const char* type, double packets, double kilobytes,
+              double packetsRaw, double kilobytesRaw) {
+      uint32_t faceDescr = 0;
+      if (faceId != nfd::face::INVALID_FACEID) {
+        NS_ASSERT(m_faceInfos.find(faceId) != m_faceInfos.end());
+        faceDescr = sink.GetStringId(m_faceInfos.find(faceId)->second);
+      }
+      RateRecord record = {time, faceId, m_nodeStringId, faceDescr, sink.GetStringId(type), 0,
+                           packets, kilobytes, packetsRaw, kilobytesRaw};
+      sink.Append(RATE_RECORD, record);
+    });
+}
+
+void
+L3RateTracer::Update(const Reporter& report) const
+{
   for (auto& stats : m_stats) {
     if (stats.first == nfd::face::INVALID_FACEID)
       continue;
@@ -283,6 +359,23 @@ L3RateTracer::Print(std::ostream& os) const
     //PRINTER("OutTimedOutInterests", m_outTimedOutInterests)
   }
 
+  if (g_isTxQueueTraced) {
+    for (const auto& item : m_txQueueFaces) {
+      auto face = item.second.lock();
+      if (face == nullptr) {
+        continue;
+      }
+      // only faces with NetDeviceTransport are added in AddInfo
+      auto transport = static_cast<NetDeviceTransport*>(face->getTransport());
+      Ptr<ns3::QueueBase> txQueue = transport->GetTxQueue();
+      if (txQueue != nullptr) {
+        double packets = txQueue->GetNPackets();
+        double kilobytes = txQueue->GetNBytes() / 1024.0;
+        report(item.first, "TxQueue", packets, kilobytes, packets, kilobytes);
+      }
+    }
+  }
+
   {
     auto i = m_stats.find(nfd::face::INVALID_FACEID);
     if (i != m_stats.end()) {
@@ -293,6 +386,227 @@ L3RateTracer::Print(std::ostream& os) const
   }
 }
 
+/**
+ * @brief Single periodic printer of L3RateTracer::InstallAggregated
+ */
+class L3RateAggregator : boost::noncopyable
+{
+public:
+  typedef L3RateTracer::Stats Stats;
+
+  L3RateAggregator(L3RateTracer::Granularity granularity, const Time& period,
+                   shared_ptr<std::ostream> os, shared_ptr<TraceSink> sink,
+                   std::vector<Ptr<L3RateTracer>> tracers)
+    : m_granularity(granularity)
+    , m_period(period)
+    , m_os(std::move(os))
+    , m_sink(std::move(sink))
+    , m_tracers(std::move(tracers))
+  {
+    m_printEvent = Simulator::Schedule(m_period, &L3RateAggregator::PeriodicPrinter, this);
+  }
+
+  ~L3RateAggregator()
+  {
+    m_printEvent.Cancel();
+  }
+
+private:
+  typedef std::function<void(const std::string& group, const char* type, double packets,
+                             double kilobytes, double packetsRaw, double kilobytesRaw)> Reporter;
+
+  void
+  PeriodicPrinter()
+  {
+    if (m_tracerGroups.empty()) {
+      ResolveGroups();
+    }
+    Collect();
+
+    if (m_sink != nullptr) {
+      int64_t time = Simulator::Now().GetTimeStep();
+      TraceSink& sink = *m_sink;
+      Update([&] (const std::string& group, const char* type, double packets, double kilobytes,
+                  double packetsRaw, double kilobytesRaw) {
+          RateRecord record = {time, nfd::face::INVALID_FACEID, sink.GetStringId(group), 0,
+                               sink.GetStringId(type), 0,
+                               packets, kilobytes, packetsRaw, kilobytesRaw};
+          sink.Append(RATE_RECORD, record);
+        });
+    }
+    else {
+      Time time = Simulator::Now();
+      Update([&] (const std::string& group, const char* type, double packets, double kilobytes,
+                  double packetsRaw, double kilobytesRaw) {
+          printLine(*m_os, time, group, nfd::face::INVALID_FACEID, "", type, packets, kilobytes,
+                    packetsRaw, kilobytesRaw);
+        });
+    }
+
+    m_printEvent = Simulator::Schedule(m_period, &L3RateAggregator::PeriodicPrinter, this);
+  }
+
+  /**
+   * @brief Assign each tracer to its groups, in order of first appearance
+   */
+  void
+  ResolveGroups()
+  {
+    std::map<std::string, size_t> index;
+    auto getGroup = [&] (const std::string& group) {
+      auto i = index.find(group);
+      if (i == index.end()) {
+        i = index.emplace(group, m_stats.size()).first;
+        m_stats.emplace_back(group, std::tuple<Stats, Stats, Stats, Stats>());
+      }
+      return i->second;
+    };
+
+    m_tracerGroups.resize(m_tracers.size());
+    for (size_t i = 0; i < m_tracers.size(); ++i) {
+      const L3RateTracer& tracer = *m_tracers[i];
+      switch (m_granularity) {
+      case L3RateTracer::Granularity::NODE:
+        m_tracerGroups[i].push_back(getGroup(tracer.m_node));
+        break;
+      case L3RateTracer::Granularity::REGION: {
+        Ptr<L3Protocol> l3;
+        if (tracer.m_nodePtr != 0) {
+          l3 = tracer.m_nodePtr->GetObject<L3Protocol>();
+        }
+        if (l3 != 0) {
+          for (const Name& region : l3->getForwarder()->getNetworkRegionTable()) {
+            m_tracerGroups[i].push_back(getGroup(region.toUri()));
+          }
+        }
+        if (m_tracerGroups[i].empty()) {
+          m_tracerGroups[i].push_back(getGroup("none"));
+        }
+        break;
+      }
+      case L3RateTracer::Granularity::NETWORK:
+        m_tracerGroups[i].push_back(getGroup("all"));
+        break;
+      }
+    }
+  }
+
+  /**
+   * @brief Move counters of the last period from the tracers into the groups
+   */
+  void
+  Collect()
+  {
+    for (size_t i = 0; i < m_tracers.size(); ++i) {
+      L3RateTracer& tracer = *m_tracers[i];
+      for (const auto& face : tracer.m_stats) {
+        if (face.first == nfd::face::INVALID_FACEID) {
+          continue; // node-wide counters are not per-face rates
+        }
+        for (size_t group : m_tracerGroups[i]) {
+          add(std::get<0>(m_stats[group].second), std::get<0>(face.second));
+          add(std::get<1>(m_stats[group].second), std::get<1>(face.second));
+        }
+      }
+      tracer.Reset();
+    }
+  }
+
+  void
+  Update(const Reporter& report)
+  {
+    // same packet types as written per face by L3RateTracer::Update
+    for (auto& stats : m_stats) {
+      PRINTER("InData", m_inData);
+
+      std::get<0>(stats.second).Reset();
+      std::get<1>(stats.second).Reset();
+    }
+  }
+
+  static void
+  add(Stats& sum, const Stats& stats)
+  {
+    sum.m_inInterests += stats.m_inInterests;
+    sum.m_outInterests += stats.m_outInterests;
+    sum.m_inData += stats.m_inData;
+    sum.m_outData += stats.m_outData;
+    sum.m_inNack += stats.m_inNack;
+    sum.m_outNack += stats.m_outNack;
+    sum.m_satisfiedInterests += stats.m_satisfiedInterests;
+    sum.m_timedOutInterests += stats.m_timedOutInterests;
+    sum.m_outSatisfiedInterests += stats.m_outSatisfiedInterests;
+    sum.m_outTimedOutInterests += stats.m_outTimedOutInterests;
+  }
+
+private:
+  L3RateTracer::Granularity m_granularity;
+  Time m_period;
+  EventId m_printEvent;
+  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
+
+  std::vector<Ptr<L3RateTracer>> m_tracers;
+  std::vector<std::vector<size_t>> m_tracerGroups; ///< indices in m_stats for each tracer
+  std::vector<std::pair<std::string, std::tuple<Stats, Stats, Stats, Stats>>> m_stats;
+};
+
+void
+L3RateTracer::InstallAggregated(const std::string& file, Granularity granularity,
+                                Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  shared_ptr<std::ostream> outputStream;
+  shared_ptr<TraceSink> sink;
+  if (!TraceSink::OpenOutput(file, TraceSink::L3_RATE, outputStream, sink)) {
+    return;
+  }
+
+  std::vector<Ptr<L3RateTracer>> tracers;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, *node);
+    trace->m_printEvent.Cancel(); // counters are collected by L3RateAggregator
+    trace->m_period = averagingPeriod;
+    tracers.push_back(trace);
+  }
+
+  if (outputStream != nullptr) {
+    printHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_aggregators.push_back(make_shared<L3RateAggregator>(granularity, averagingPeriod, outputStream,
+                                                        sink, std::move(tracers)));
+}
+
+size_t
+L3RateTracer::ConvertToTsv(TraceReader& reader, std::ostream& os)
+{
+  if (reader.GetFormat() != TraceSink::L3_RATE) {
+    throw std::runtime_error("Not an L3 rate trace");
+  }
+
+  printHeader(os);
+  os << "\n";
+
+  size_t nRecords = 0;
+  TraceReader::Entry entry;
+  while (reader.Next(entry)) {
+    if (entry.type != RATE_RECORD) {
+      continue;
+    }
+    RateRecord record = entry.as<RateRecord>();
+    std::string faceDescr;
+    if (record.faceId != nfd::face::INVALID_FACEID) {
+      faceDescr = reader.GetString(record.faceDescr);
+    }
+    printLine(os, reader.GetTime(record.time), reader.GetString(record.node), record.faceId,
+              faceDescr, reader.GetString(record.type).c_str(), record.packets, record.kilobytes,
+              record.packetsRaw, record.kilobytesRaw);
+    ++nRecords;
+  }
+  return nRecords;
+}
+
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
@@ -398,6 +712,9 @@ L3RateTracer::AddInfo(const Face& face)
 {
   if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
     m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+    if (dynamic_cast<NetDeviceTransport*>(face.getTransport()) != nullptr) {
+      m_txQueueFaces.insert(make_pair(face.getId(), face.shared_from_this()));
+    }
   }
 }
 
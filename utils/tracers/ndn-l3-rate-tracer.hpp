@@ -28,6 +28,7 @@
 #include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
+#include <functional>
 #include <tuple>
 #include <map>
 #include <list>
@@ -35,16 +36,30 @@
 namespace ns3 {
 namespace ndn {
 
+class TraceSink;
+class TraceReader;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
  */
 class L3RateTracer : public L3Tracer {
 public:
+  /**
+   * @brief Granularity of the rates written by InstallAggregated
+   */
+  enum class Granularity {
+    NODE,   ///< sum over all faces of each node
+    REGION, ///< sum over all nodes with the same network region name
+    NETWORK ///< sum over all nodes
+  };
+
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin or .bin.gz, binary records are written using
+   *             TraceSink
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -74,6 +89,27 @@ public:
   static void
   Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on all simulation nodes, writing only aggregated rates
+   *
+   * Instead of a print event per node, a single event per averaging period walks all nodes,
+   * sums their per-face counters into groups of the requested @p granularity, and writes one
+   * line per group and packet type.  The lines have the usual format, with node name, region
+   * name, or "all" in the Node column, and -1 as FaceId.
+   *
+   * Regions are names in the network region table of the node
+   * (see NetworkRegionTableHelper), looked up at the first print.  A node in several regions is
+   * counted in each of them, and nodes without region names form region "none".
+   *
+   * @param file File to which traces will be written (see InstallAll)
+   * @param granularity Granularity of the written rates
+   * @param averagingPeriod Defines averaging period for the rate calculation,
+   *        as well as how often data will be written into the trace file
+   */
+  static void
+  InstallAggregated(const std::string& file, Granularity granularity,
+                    Time averagingPeriod = Seconds(0.5));
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -83,6 +119,21 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Enable or disable tracing of transmit queue occupancy (disabled by default)
+   *
+   * When enabled, tracers additionally write a "TxQueue" line for every traced face backed by
+   * a NetDevice with a transmit queue (see NetDeviceTransport::GetTxQueue).  Unlike the other
+   * lines, the values are not rates: Packets and PacketRaw are the number of packets, Kilobytes
+   * and KilobytesRaw the size of the queue at the time of printing.  Aggregated tracers
+   * (see InstallAggregated) do not write these lines.
+   *
+   * Only NetDevices with a "TxQueue" attribute (e.g., point-to-point and CSMA) have a queue to
+   * trace; faces on other devices (e.g., WiFi and LTE) get no "TxQueue" lines.
+   */
+  static void
+  SetTxQueueTracing(bool isEnabled);
+
   /**
    * @brief Trace constructor that attaches to the node using node pointer
    * @param os    reference to the output stream
@@ -125,6 +176,14 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Convert binary trace (see TraceSink) into the tab-separated format, with header
+   * @return number of converted records
+   * @throw std::runtime_error if the trace is not an L3 rate trace or is malformed
+   */
+  static size_t
+  ConvertToTsv(TraceReader& reader, std::ostream& os);
+
 protected:
   // from L3Tracer
   virtual void
@@ -152,6 +211,27 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
+  typedef std::function<void(nfd::FaceId faceId, const char* type, double packets,
+                             double kilobytes, double packetsRaw, double kilobytesRaw)> Reporter;
+
+  /**
+   * @brief Update averaged rates and pass them to @p report
+   */
+  void
+  Update(const Reporter& report) const;
+
+  /**
+   * @brief Write current rates as binary records
+   */
+  void
+  Write(TraceSink& sink) const;
+
+  /**
+   * @brief Write records into binary @p sink instead of the text stream, if not nullptr
+   */
+  void
+  SetSink(shared_ptr<TraceSink> sink);
+
   void
   SetAveragingPeriod(const Time& period);
 
@@ -165,12 +245,17 @@ private:
   AddInfo(const Face& face);
 
 private:
+  friend class L3RateAggregator;
+
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
+  uint32_t m_nodeStringId;
   Time m_period;
   EventId m_printEvent;
 
   mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
   std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  std::map<nfd::FaceId, std::weak_ptr<const Face>> m_txQueueFaces; // faces with a transmit queue
 };
 
 } // namespace ndn
@@ -0,0 +1,304 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/log.h"
+
+#include <boost/iostreams/filter/gzip.hpp>
+
+#include <functional>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+const uint16_t TraceSink::STRING_ENTRY = 0;
+const size_t TraceSink::BLOCK_SIZE = 256 * 1024;
+
+static const char MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'C', 'E', '2'};
+static const char MAGIC_V1[8] = {'N', 'D', 'N', 'T', 'R', 'C', 'E', '1'}; // no time resolution
+static const char GZIP_SUFFIX[] = ".bin.gz";
+static const char BIN_SUFFIX[] = ".bin";
+
+static bool
+endsWith(const std::string& str, const char* suffix)
+{
+  size_t length = std::strlen(suffix);
+  return str.size() >= length && str.compare(str.size() - length, length, suffix) == 0;
+}
+
+bool
+TraceSink::IsBinaryFile(const std::string& file)
+{
+  return endsWith(file, BIN_SUFFIX) || endsWith(file, GZIP_SUFFIX);
+}
+
+shared_ptr<TraceSink>
+TraceSink::Open(const std::string& file, Format format)
+{
+  try {
+    return make_shared<TraceSink>(file, format, endsWith(file, GZIP_SUFFIX) ? GZIP : NONE);
+  }
+  catch (const std::runtime_error& e) {
+    NS_LOG_ERROR(e.what() << ". Tracing disabled");
+    return nullptr;
+  }
+}
+
+bool
+TraceSink::OpenOutput(const std::string& file, Format format, shared_ptr<std::ostream>& os,
+                      shared_ptr<TraceSink>& sink)
+{
+  if (IsBinaryFile(file)) {
+    sink = Open(file, format);
+    return sink != nullptr;
+  }
+
+  if (file == "-") {
+    os = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+    return true;
+  }
+
+  auto ofs = make_shared<std::ofstream>();
+  ofs->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!ofs->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return false;
+  }
+  os = ofs;
+  return true;
+}
+
+TraceSink::TraceSink(const std::string& file, Format format, Compression compression)
+  : m_head(0)
+  , m_tail(0)
+  , m_isClosing(false)
+{
+  m_file.open(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!m_file.is_open()) {
+    throw std::runtime_error("File " + file + " cannot be opened for writing");
+  }
+
+  uint32_t header[3] = {format, compression, static_cast<uint32_t>(Time::GetResolution())};
+  m_file.write(MAGIC, sizeof(MAGIC));
+  m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  if (compression == GZIP) {
+    m_os.push(boost::iostreams::gzip_compressor());
+  }
+  m_os.push(m_file);
+
+  m_block.reserve(BLOCK_SIZE);
+  m_writer = std::thread(&TraceSink::WriterLoop, this);
+}
+
+TraceSink::~TraceSink()
+{
+  Flush();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isClosing = true;
+  }
+  m_cv.notify_all();
+  m_writer.join();
+
+  m_os.reset(); // finishes compressed stream
+  m_file.close();
+}
+
+uint32_t
+TraceSink::GetStringId(const std::string& str)
+{
+  auto it = m_strings.find(str);
+  if (it != m_strings.end()) {
+    return it->second;
+  }
+
+  uint32_t id = static_cast<uint32_t>(m_strings.size());
+  m_strings.emplace(str, id);
+
+  std::vector<uint8_t> payload(sizeof(id) + str.size());
+  std::memcpy(payload.data(), &id, sizeof(id));
+  std::memcpy(payload.data() + sizeof(id), str.data(), str.size());
+  AppendEntry(STRING_ENTRY, payload.data(), payload.size());
+  return id;
+}
+
+void
+TraceSink::AppendEntry(uint16_t type, const void* payload, size_t size)
+{
+  if (size > UINT16_MAX - sizeof(uint32_t)) {
+    NS_LOG_ERROR("Trace entry of " << size << " bytes is too large, truncated");
+    size = UINT16_MAX - sizeof(uint32_t);
+  }
+
+  if (m_block.size() + sizeof(uint16_t) * 2 + size > BLOCK_SIZE) {
+    Submit();
+  }
+
+  uint16_t header[2] = {type, static_cast<uint16_t>(size)};
+  const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(header);
+  const uint8_t* payloadBytes = reinterpret_cast<const uint8_t*>(payload);
+  m_block.insert(m_block.end(), headerBytes, headerBytes + sizeof(header));
+  m_block.insert(m_block.end(), payloadBytes, payloadBytes + size);
+}
+
+void
+TraceSink::Flush()
+{
+  if (!m_block.empty()) {
+    Submit();
+  }
+}
+
+void
+TraceSink::Submit()
+{
+  size_t head = m_head.load(std::memory_order_relaxed);
+  if (head - m_tail.load(std::memory_order_acquire) == RING_SIZE) {
+    NS_LOG_DEBUG("Writer thread is behind, waiting");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this, head] { return head - m_tail.load(std::memory_order_acquire) < RING_SIZE; });
+  }
+
+  // the slot has been written out, its buffer is reused for the next block
+  m_ring[head % RING_SIZE].swap(m_block);
+  m_block.clear();
+  m_head.store(head + 1, std::memory_order_release);
+
+  { std::lock_guard<std::mutex> lock(m_mutex); }
+  m_cv.notify_all();
+}
+
+void
+TraceSink::WriterLoop()
+{
+  while (true) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this, tail] {
+          return tail != m_head.load(std::memory_order_acquire) || m_isClosing;
+        });
+      if (tail == m_head.load(std::memory_order_acquire)) {
+        break; // closing, nothing left
+      }
+    }
+
+    const std::vector<uint8_t>& block = m_ring[tail % RING_SIZE];
+    m_os.write(reinterpret_cast<const char*>(block.data()), block.size());
+
+    m_tail.store(tail + 1, std::memory_order_release);
+    { std::lock_guard<std::mutex> lock(m_mutex); }
+    m_cv.notify_all();
+  }
+
+  m_os.flush();
+}
+
+TraceReader::TraceReader(const std::string& file)
+{
+  m_file.open(file.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!m_file.is_open()) {
+    throw std::runtime_error("Cannot open " + file);
+  }
+
+  char magic[sizeof(MAGIC)];
+  uint32_t header[3] = {0, 0, Time::NS};
+  m_file.read(magic, sizeof(magic));
+  bool isV1 = m_file && std::memcmp(magic, MAGIC_V1, sizeof(MAGIC_V1)) == 0;
+  m_file.read(reinterpret_cast<char*>(header), isV1 ? sizeof(uint32_t) * 2 : sizeof(header));
+  if (!m_file || (!isV1 && std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) ||
+      header[1] > TraceSink::GZIP || header[2] >= Time::LAST) {
+    throw std::runtime_error(file + " is not a binary ndnSIM trace");
+  }
+  m_format = static_cast<TraceSink::Format>(header[0]);
+  m_resolution = static_cast<Time::Unit>(header[2]);
+
+  if (header[1] == TraceSink::GZIP) {
+    m_is.push(boost::iostreams::gzip_decompressor());
+  }
+  m_is.push(m_file);
+}
+
+bool
+TraceReader::Next(Entry& entry)
+{
+  while (true) {
+    uint16_t header[2];
+    m_is.read(reinterpret_cast<char*>(header), sizeof(header));
+    std::streamsize nRead = m_is.gcount();
+    if (nRead == 0) {
+      return false;
+    }
+    if (nRead != sizeof(header)) {
+      throw std::runtime_error("Binary trace is truncated");
+    }
+
+    m_payload.resize(header[1]);
+    if (!m_payload.empty()) {
+      m_is.read(reinterpret_cast<char*>(m_payload.data()), m_payload.size());
+      if (m_is.gcount() != static_cast<std::streamsize>(m_payload.size())) {
+        throw std::runtime_error("Binary trace is truncated");
+      }
+    }
+
+    if (header[0] == TraceSink::STRING_ENTRY) {
+      uint32_t id = 0;
+      if (m_payload.size() < sizeof(id)) {
+        throw std::runtime_error("Malformed string definition in binary trace");
+      }
+      std::memcpy(&id, m_payload.data(), sizeof(id));
+      m_strings[id].assign(m_payload.begin() + sizeof(id), m_payload.end());
+      continue;
+    }
+
+    entry.type = header[0];
+    entry.size = header[1];
+    entry.payload = m_payload.data();
+    return true;
+  }
+}
+
+Time
+TraceReader::GetTime(int64_t timeStep) const
+{
+  if (m_resolution == Time::GetResolution()) {
+    return TimeStep(timeStep);
+  }
+
+  // recorded times and delays are never negative
+  return Time::FromInteger(static_cast<uint64_t>(timeStep), m_resolution);
+}
+
+const std::string&
+TraceReader::GetString(uint32_t id) const
+{
+  auto it = m_strings.find(id);
+  if (it == m_strings.end()) {
+    throw std::runtime_error("Undefined string in binary trace");
+  }
+  return it->second;
+}
+
+} // namespace ndn
+} // namespace ns3
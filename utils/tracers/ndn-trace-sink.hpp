@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_TRACERS_NDN_TRACE_SINK_HPP
+#define NDNSIM_UTILS_TRACERS_NDN_TRACE_SINK_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Binary trace file shared by the tracers, written by a background thread
+ *
+ * Tracers append fixed-size records (and, once per distinct value, strings such as node names)
+ * on the simulation thread.  Entries are accumulated in blocks, and full blocks are passed to
+ * a writer thread through a lock-free single-producer single-consumer ring of recycled
+ * buffers, so the simulation thread neither formats text nor waits for the disk, unless the
+ * writer falls behind by the whole ring.
+ *
+ * Tracers use the sink when the trace file name ends with `.bin` (uncompressed) or `.bin.gz`
+ * (gzip-compressed by the writer thread).  Such files can be converted to the usual
+ * tab-separated format with the `ndn-trace-to-tsv` program:
+ *
+ *     ./waf --run "ndn-trace-to-tsv --input=app-delays-trace.bin --output=app-delays-trace.txt"
+ *
+ * The file starts with 8-byte magic "NDNTRCE2", 4-byte TraceSink::Format, 4-byte
+ * TraceSink::Compression, and 4-byte Time::Unit of the simulation's time resolution, followed
+ * by (possibly compressed) entries.  Tracers record times as TimeSteps, which are converted
+ * back with this resolution (see TraceReader::GetTime), whatever the resolution of the
+ * converting program.  Each entry is 2-byte type,
+ * 2-byte payload size, and the payload, all in the host byte order.  Entries of type
+ * STRING_ENTRY define strings (4-byte id followed by characters), other types are defined by
+ * the tracer that produced the file.
+ */
+class TraceSink : boost::noncopyable {
+public:
+  enum Format : uint32_t {
+    APP_DELAY = 1,
+    L3_RATE = 2,
+    L2_RATE = 3,
+    CS = 4
+  };
+
+  enum Compression : uint32_t {
+    NONE = 0,
+    GZIP = 1
+  };
+
+  static const uint16_t STRING_ENTRY;
+
+  /**
+   * @brief Check whether @p file should be written through TraceSink
+   */
+  static bool
+  IsBinaryFile(const std::string& file);
+
+  /**
+   * @brief Open the trace file, choosing compression by its name
+   * @return the sink, or nullptr if the file cannot be opened (the error is logged)
+   */
+  static shared_ptr<TraceSink>
+  Open(const std::string& file, Format format);
+
+  /**
+   * @brief Open output of a tracer
+   *
+   * If IsBinaryFile(@p file), @p sink is opened.  Otherwise, @p os is set to a text file or,
+   * if @p file is "-", to the standard output.
+   *
+   * @return false if the file cannot be opened (the error is logged)
+   */
+  static bool
+  OpenOutput(const std::string& file, Format format, shared_ptr<std::ostream>& os,
+             shared_ptr<TraceSink>& sink);
+
+  /**
+   * @throw std::runtime_error if @p file cannot be opened
+   */
+  TraceSink(const std::string& file, Format format, Compression compression);
+
+  /**
+   * @brief Write all remaining entries and stop the writer thread
+   */
+  ~TraceSink();
+
+  /**
+   * @brief Append record of tracer-defined @p type
+   */
+  template<typename Record>
+  void
+  Append(uint16_t type, const Record& record)
+  {
+    static_assert(std::is_trivially_copyable<Record>::value, "Record must be trivially copyable");
+    static_assert(sizeof(Record) <= UINT16_MAX, "Record is too large");
+    AppendEntry(type, &record, sizeof(record));
+  }
+
+  /**
+   * @brief Get id of the string, defining it in the trace on first use
+   */
+  uint32_t
+  GetStringId(const std::string& str);
+
+  /**
+   * @brief Pass the current block to the writer thread without waiting for it to be written
+   */
+  void
+  Flush();
+
+private:
+  void
+  AppendEntry(uint16_t type, const void* payload, size_t size);
+
+  void
+  Submit();
+
+  void
+  WriterLoop();
+
+private:
+  static const size_t BLOCK_SIZE;
+  static const size_t RING_SIZE = 8;
+
+  std::vector<uint8_t> m_block; ///< block being filled by the simulation thread
+  std::vector<uint8_t> m_ring[RING_SIZE];
+  std::atomic<size_t> m_head; ///< number of submitted blocks
+  std::atomic<size_t> m_tail; ///< number of written blocks
+  std::atomic<bool> m_isClosing;
+
+  // used only to sleep while the ring is empty (writer) or full (simulation thread)
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+
+  std::unordered_map<std::string, uint32_t> m_strings;
+
+  std::ofstream m_file;
+  boost::iostreams::filtering_ostream m_os;
+  std::thread m_writer;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Sequential reader of the files written by TraceSink
+ */
+class TraceReader : boost::noncopyable {
+public:
+  struct Entry {
+    uint16_t type;
+    uint16_t size;
+    const uint8_t* payload;
+
+    template<typename Record>
+    Record
+    as() const
+    {
+      Record record;
+      if (size != sizeof(Record)) {
+        throw std::runtime_error("Unexpected size of trace entry");
+      }
+      std::memcpy(&record, payload, sizeof(record));
+      return record;
+    }
+  };
+
+  /**
+   * @throw std::runtime_error if @p file cannot be read or is not a binary trace
+   */
+  explicit
+  TraceReader(const std::string& file);
+
+  TraceSink::Format
+  GetFormat() const
+  {
+    return m_format;
+  }
+
+  /**
+   * @brief Get time resolution of the simulation that wrote the trace
+   *
+   * Traces written before the resolution was recorded ("NDNTRCE1") are assumed to use the
+   * default resolution (nanoseconds).
+   */
+  Time::Unit
+  GetResolution() const
+  {
+    return m_resolution;
+  }
+
+  /**
+   * @brief Convert time recorded in the trace as @p timeStep (see Time::GetTimeStep)
+   */
+  Time
+  GetTime(int64_t timeStep) const;
+
+  /**
+   * @brief Read the next tracer-defined entry, processing string definitions on the way
+   * @return false at the end of the trace
+   * @throw std::runtime_error if the trace is truncated
+   */
+  bool
+  Next(Entry& entry);
+
+  /**
+   * @throw std::runtime_error if the string is not defined
+   */
+  const std::string&
+  GetString(uint32_t id) const;
+
+private:
+  std::ifstream m_file;
+  boost::iostreams::filtering_istream m_is;
+  TraceSink::Format m_format;
+  Time::Unit m_resolution;
+  std::vector<uint8_t> m_payload;
+  std::unordered_map<uint32_t, std::string> m_strings;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_TRACERS_NDN_TRACE_SINK_HPP